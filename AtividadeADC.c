@@ -6,14 +6,41 @@
 
 // ======= Includes =======
 #include <stdio.h>              // Biblioteca padrão de entrada/saída
-#include "pico/stdlib.h"        // Biblioteca principal do Raspberry Pi Pico
-#include "hardware/adc.h"       // Biblioteca para controle do ADC
-#include "hardware/pwm.h"       // Biblioteca para controle do PWM
-#include "hardware/i2c.h"       // Biblioteca para comunicação I2C
+#include "inc/hal.h"            // Tempo, GPIO, PWM, ADC, I2C e timers (Pico ou host)
 #include "inc/ssd1306.h"        // Biblioteca do display OLED
-#include "inc/font.h"           // Biblioteca de fontes para o display
+#include "inc/border.h"         // Estilos de borda da tela
+#include "inc/joystick.h"       // Captura contínua do joystick via ADC + DMA
+#include "inc/axis_filter.h"    // Decimação e filtragem dos eixos em ponto fixo
+#include "inc/calibration.h"    // Calibração dos eixos gravada na flash
+#include "inc/axis_map.h"       // Mapeamento dos eixos sem divisão
+#include "inc/scheduler.h"      // Laço de controle com tick fixo
+#include "inc/triple_buffer.h"  // Instantâneos do estado para o display
+#include "inc/event_queue.h"    // Eventos dos botões gerados na IRQ
+#include "inc/debounce.h"       // Debounce dos botões por amostragem
+#include "inc/gesture.h"        // Clique, duplo clique, long press e repetição
+#include "inc/latency_trace.h"  // Latência entrada -> LEDs/display (só em debug)
+#include "inc/input_trace.h"    // Captura e reprodução das entradas brutas
+#include "inc/frame_profiler.h" // FPS, tempo de desenho e de barramento na tela
+#include "inc/app_config.h"     // Parâmetros compartilhados com bench/ e tests/
 
 // ======= Definições de Pinos =======
+// Com DUAL_CORE o núcleo 1 desenha e transmite os quadros enquanto o
+// núcleo 0 cuida de ADC, botões e PWM; com 0 tudo roda no núcleo 0.
+// O build do host (HAL_HOST) tem um só fluxo de execução.
+#ifndef DUAL_CORE
+#define DUAL_CORE (!HAL_HOST)
+#endif
+
+#if DUAL_CORE
+#include "pico/multicore.h"     // Execução do display no segundo núcleo
+#endif
+#if HAL_HOST
+#include <time.h>               // Tempo real gasto na reprodução de traces
+#include "inc/ssd1306_emu.h"    // Painel emulado a partir do tráfego I2C
+#else
+#include "inc/ssd1306_dma.h"    // Envio assíncrono do display via DMA
+#endif
+
 // Pinos do Joystick
 #define VRX_PIN 26             // Pino analógico X do joystick (movimento horizontal)
 #define VRY_PIN 27             // Pino analógico Y do joystick (movimento vertical)
@@ -26,164 +53,637 @@
 #define LED_B_PIN 12           // Pino do LED azul (PWM)
 
 // Configuração da comunicação I2C
-#define I2C_PORT i2c1          // Porta I2C utilizada
+#define I2C_PORT 1             // Porta I2C utilizada (i2c1)
 #define I2C_SDA 14             // Pino de dados I2C
 #define I2C_SCL 15             // Pino de clock I2C
 #define ENDERECO 0x3C          // Endereço I2C do display OLED
 
 // ======= Variáveis Globais =======
 ssd1306_t ssd;                 // Estrutura de controle do display OLED
+#if HAL_HOST
+ssd1306_emu_t panel;           // Painel emulado que recebe as escritas I2C
+ssd1306_bus_stats_t panel_frame;    // Tráfego do último quadro enviado
+#else
+ssd1306_dma_t ssd_dma;         // Canal DMA usado para enviar os quadros ao display
+#endif
+joystick_t joystick;           // Captura round-robin dos eixos X/Y
+joystick_filter_t joystick_filter;  // Filtros dos eixos X/Y
+joystick_calibration_t calibration; // Centro, extremos e zona morta dos eixos
+axis_map_t map_square_x, map_square_y, map_led;  // Mapeamentos pré-calculados
+scheduler_t scheduler;         // Escalonador das tarefas de entrada e display
+
+// Estado necessário para desenhar um quadro, publicado pela entrada
+typedef struct {
+    int16_t square_x, square_y;
+    uint8_t border_style;
+    bool overlay;               // Mostra a sobreposição do frame_profiler
+#if LATENCY_TRACE
+    trace_record_t trace;       // Etapas de entrada que geraram este estado
+#endif
+} render_state_t;
+
+event_queue_t input_events;    // Bordas dos botões, da IRQ para o laço principal
+debounce_t buttons;            // Debounce dos botões (um contador por pino)
+hal_timer_t button_timer;           // Timer de amostragem dos botões
+gesture_button_t sw_gesture;        // Gestos do botão do joystick
+gesture_button_t button_a_gesture;  // Gestos do botão A
+uint8_t led_dim = 0;           // Redução do brilho dos LEDs RGB (shift de 0 a 3)
+render_state_t render_slots[3];     // Slots do buffer triplo
+triple_buffer_t render_buffer;      // Último estado publicado para o display
+frame_profiler_t profiler;          // Contadores do display (dono do display)
+uint32_t bus_start_us;              // Início da transmissão do quadro atual
+#if LATENCY_TRACE
+latency_trace_t latency_trace;      // Histogramas (acessados só pelo dono do display)
+trace_record_t frame_trace;         // Quadro em transmissão
+#endif
+volatile bool capture_requested = false;  // Captura pedida pelo console
+bool capture_enabled = false;  // Registros da captura sendo enviados pelo USB
+uint32_t capture_start_us;     // Início da captura (tempo 0 do trace)
+uint32_t capture_last_us;      // Tempo do último registro enviado
 int square_x = 60;             // Posição inicial X do quadrado no display
 int square_y = 28;             // Posição inicial Y do quadrado no display
 bool led_green_state = false;  // Estado do LED verde
 bool pwm_enabled = true;       // Estado do PWM
-uint8_t border_style = 0;      // Estilo da borda (0-2)
+uint8_t border_style = 0;      // Estilo da borda (0 a BORDER_STYLES - 1)
+volatile bool overlay_enabled = false;  // Sobreposição de desempenho no canto da tela
 
 // ======= Constantes =======
-#define JOYSTICK_CENTER 2048  // Valor central do ADC (4095/2) - Posição de repouso do joystick
-#define ADC_MAX 4095         // Valor máximo do ADC de 12 bits (2^12 - 1)
-#define PWM_MAX 65535       // Valor máximo do PWM de 16 bits (2^16 - 1)
+#define CALIBRATION_SWEEP_MS 5000   // Tempo para girar o joystick até os extremos
+#define TICK_US 1000                // Tick do escalonador (1 kHz)
+#define INPUT_PERIOD 1              // Entrada e PWM a cada tick
+#define DISPLAY_PERIOD 20           // Quadro do display a cada 20 ticks (50 Hz)
+#define BUTTON_MASK ((1u << SW_PIN) | (1u << BUTTON_A_PIN))
+#define LED_DIM_STEPS 4             // Níveis de brilho percorridos segurando o botão A
+#define REPLAY_TAIL_US 1000000      // Tempo simulado após o último registro do trace
+#define PROFILER_WINDOW_US 1000000  // Janela das médias da sobreposição
 
 // ======= Funções de Configuração PWM =======
 void init_pwm(uint gpio) {
-    // Configura o pino para função PWM
-    gpio_set_function(gpio, GPIO_FUNC_PWM);
-    uint slice_num = pwm_gpio_to_slice_num(gpio);
-    // Define o valor máximo do ciclo PWM
-    pwm_set_wrap(slice_num, PWM_MAX);
-    // Ativa o PWM
-    pwm_set_enabled(slice_num, true);
+    // Configura o pino para função PWM com ciclo de PWM_MAX e ativa o PWM
+    hal_pwm_init(gpio, PWM_MAX);
 }
 
 void set_pwm_duty(uint gpio, uint16_t duty) {
     // Define o duty cycle do PWM, considerando se está habilitado
-    pwm_set_gpio_level(gpio, pwm_enabled ? duty : 0);
+    hal_pwm_set(gpio, pwm_enabled ? duty >> led_dim : 0);
 }
 
 // ======= Manipulador de Interrupções =======
-void gpio_callback(uint gpio, uint32_t events) {
-    static uint32_t last_interrupt_time = 0;
-    uint32_t interrupt_time = time_us_32();
-    
-    // Implementa debounce de 200ms
-    if (interrupt_time - last_interrupt_time > 200000) {
-        if (gpio == SW_PIN) {
+bool button_timer_callback(void *user) {
+    // Amostra todos os botões de uma vez; só as mudanças já estáveis viram
+    // eventos, com o instante da primeira leitura do novo nível
+    uint32_t changed = debounce_update(&buttons, hal_gpio_get_all(), hal_time_us());
+    while (changed) {
+        uint pin = __builtin_ctz(changed);
+        changed &= changed - 1;
+        // Botões com pull-up: nível baixo é pressionado (borda de descida)
+        uint8_t edge = (buttons.state >> pin) & 1 ? HAL_EDGE_RISE : HAL_EDGE_FALL;
+        event_queue_push(&input_events, pin, edge, buttons.edge_us);
+    }
+    return true;
+}
+
+// ======= Tratamento dos Botões =======
+void handle_sw_gesture(gesture_t gesture) {
+    switch (gesture) {
+        case GESTURE_CLICK:
             // Alterna estado do LED verde e estilo da borda
             led_green_state = !led_green_state;
-            gpio_put(LED_G_PIN, led_green_state);
-            border_style = (border_style + 1) % 3;
-        } else if (gpio == BUTTON_A_PIN) {
-            // Alterna estado do PWM
-            pwm_enabled = !pwm_enabled;
-        }
-        last_interrupt_time = interrupt_time;
+            hal_gpio_put(LED_G_PIN, led_green_state);
+            border_style = (border_style + 1) % BORDER_STYLES;
+            break;
+        case GESTURE_DOUBLE_CLICK:
+            // Volta ao estilo de borda anterior
+            border_style = (border_style + BORDER_STYLES - 1) % BORDER_STYLES;
+            break;
+        case GESTURE_LONG_PRESS:
+            // Restaura borda simples e LED verde apagado
+            border_style = 0;
+            led_green_state = false;
+            hal_gpio_put(LED_G_PIN, led_green_state);
+            break;
+        default:
+            break;
     }
 }
 
-// ======= Funções de Display =======
-void draw_border(ssd1306_t *ssd, uint8_t style) {
-    // Desenha diferentes estilos de borda no display
-    switch(style) {
-        case 0: // Borda simples
-            ssd1306_rect(ssd, 0, 0, WIDTH, HEIGHT, true, false);
+void handle_button_a_gesture(gesture_t gesture) {
+    switch (gesture) {
+        case GESTURE_CLICK:
+            // Alterna estado do PWM
+            pwm_enabled = !pwm_enabled;
+            break;
+        case GESTURE_DOUBLE_CLICK:
+            // Mostra/esconde FPS, tempos de desenho e de I2C e atrasos
+            overlay_enabled = !overlay_enabled;
             break;
-        case 1: // Borda dupla
-            ssd1306_rect(ssd, 0, 0, WIDTH, HEIGHT, true, false);
-            ssd1306_rect(ssd, 2, 2, WIDTH-4, HEIGHT-4, true, false);
+        case GESTURE_LONG_PRESS:
+        case GESTURE_REPEAT:
+            // Segurando, o brilho dos LEDs RGB cai pela metade a cada passo
+            led_dim = (led_dim + 1) % LED_DIM_STEPS;
             break;
-        case 2: // Borda com cantos
-            // Linhas horizontais
-            ssd1306_hline(ssd, 0, 10, 0, true);
-            ssd1306_hline(ssd, WIDTH-10, WIDTH-1, 0, true);
-            ssd1306_hline(ssd, 0, 10, HEIGHT-1, true);
-            ssd1306_hline(ssd, WIDTH-10, WIDTH-1, HEIGHT-1, true);
-            // Linhas verticais
-            ssd1306_vline(ssd, 0, 0, 10, true);
-            ssd1306_vline(ssd, 0, HEIGHT-10, HEIGHT-1, true);
-            ssd1306_vline(ssd, WIDTH-1, 0, 10, true);
-            ssd1306_vline(ssd, WIDTH-1, HEIGHT-10, HEIGHT-1, true);
+        default:
             break;
     }
 }
 
-// ======= Função Principal =======
-int main() {
-    // Inicializações básicas
-    stdio_init_all();
+void handle_input_events(void) {
+    input_event_t event;
+
+    // Os eventos trazem o instante da primeira leitura do novo nível e chegam
+    // depois da acomodação do debounce; os prazos andam pelo mesmo relógio,
+    // até onde todas as bordas já estão na fila. Lido antes de esvaziar a
+    // fila, para uma borda enfileirada no meio não ficar para trás do prazo.
+    uint32_t settled = debounce_settled_us(&buttons, hal_time_us());
+    while (event_queue_pop(&input_events, &event)) {
+        bool pressed = event.edge == HAL_EDGE_FALL;
+        if (event.pin == SW_PIN)
+            handle_sw_gesture(gesture_event(&sw_gesture, pressed, event.time_us));
+        else if (event.pin == BUTTON_A_PIN)
+            handle_button_a_gesture(gesture_event(&button_a_gesture, pressed, event.time_us));
+    }
+
+    // Prazos de long press, repetição e janela do duplo clique
+    handle_sw_gesture(gesture_update(&sw_gesture, settled));
+    handle_button_a_gesture(gesture_update(&button_a_gesture, settled));
+}
+
+// ======= Funções do Joystick =======
+void joystick_poll(uint16_t *vrx_value, uint16_t *vry_value) {
+    // Consome os blocos capturados pelo DMA desde a última chamada e
+    // passa-os pelos filtros
+    static joystick_sample_t samples[SAMPLE_RING_BLOCK_SAMPLES * 4];
+    size_t count;
+    while ((count = joystick_read(&joystick, samples, count_of(samples))) > 0)
+        joystick_filter_process(&joystick_filter, samples, count);
+    *vrx_value = axis_filter_value(&joystick_filter.x);
+    *vry_value = axis_filter_value(&joystick_filter.y);
+}
+
+void joystick_calibrate(bool sweep) {
+    // Aprende o centro com o joystick solto e, se sweep, os extremos de
+    // cada direção; sem sweep mantém os extremos padrão
+    calibration_session_t session;
+    uint16_t vrx_value, vry_value;
+
+    ssd1306_fill(&ssd, false);
+    ssd1306_draw_string(&ssd, "CALIBRANDO", 24, 20);
+    ssd1306_draw_string(&ssd, "SOLTE", 44, 36);
+    ssd1306_send_data(&ssd);
+
+    // Descarta a acomodação inicial do filtro antes de medir o repouso
+    hal_sleep_ms(200);
+    joystick_poll(&vrx_value, &vry_value);
+
+    calibration_start(&session);
+    while (session.phase == CALIBRATION_REST) {
+        hal_sleep_ms(2);
+        joystick_poll(&vrx_value, &vry_value);
+        calibration_feed(&session, vrx_value, vry_value);
+    }
+
+    if (sweep) {
+        ssd1306_fill(&ssd, false);
+        ssd1306_draw_string(&ssd, "CALIBRANDO", 24, 20);
+        ssd1306_draw_string(&ssd, "GIRE", 48, 36);
+        ssd1306_send_data(&ssd);
+        uint32_t start = hal_time_us();
+        while (hal_time_us() - start < CALIBRATION_SWEEP_MS * 1000u) {
+            hal_sleep_ms(2);
+            joystick_poll(&vrx_value, &vry_value);
+            calibration_feed(&session, vrx_value, vry_value);
+        }
+    }
+    calibration_finish(&session, &calibration);
+}
+
+void capture_sample(void) {
+    // Modo de captura: a cada tick envia pelo console a última leitura
+    // bruta do ADC e o nível dos botões antes do debounce, no formato de
+    // input_trace.h; o cabeçalho sai ao iniciar a captura
+    if (capture_requested != capture_enabled) {
+        capture_enabled = capture_requested;
+        if (capture_enabled) {
+            uint8_t header[INPUT_TRACE_HEADER_SIZE];
+            input_trace_header(header);
+            hal_console_write(header, sizeof(header));
+            capture_start_us = hal_time_us();
+            capture_last_us = 0;
+        }
+    }
+    joystick_sample_t sample;
+    if (!capture_enabled || !joystick_latest(&joystick, &sample))
+        return;
+
+    uint32_t levels = hal_gpio_get_all();
+    input_trace_record_t record = {
+        .time_us = hal_time_us() - capture_start_us,
+        .x = sample.x,
+        .y = sample.y,
+        .buttons = ((levels >> SW_PIN) & 1 ? 0 : INPUT_TRACE_SW) |
+                   ((levels >> BUTTON_A_PIN) & 1 ? 0 : INPUT_TRACE_BUTTON_A),
+    };
+    uint8_t packed[INPUT_TRACE_PACK_MAX];
+    size_t size = input_trace_pack(&capture_last_us, &record, packed);
+    hal_console_write(packed, size);
+}
+
+// ======= Tarefas =======
+void input_task(void *user) {
+    capture_sample();
+    handle_input_events();
+
+    // Leitura dos valores do Joystick
+    uint16_t vrx_value, vry_value;
+    joystick_poll(&vrx_value, &vry_value);
+#if LATENCY_TRACE
+    trace_record_t trace = {0};
+    TRACE_SET(&trace, TRACE_ADC, joystick.block_time_us);
+#endif
+
+    // Posição normalizada (-32767..32767) já com centro, zona morta e
+    // curso de cada direção aplicados
+    int32_t nx = axis_calibration_apply(&calibration.x, vrx_value);
+    int32_t ny = axis_calibration_apply(&calibration.y, vry_value);
+    uint16_t red_pwm = axis_map(&map_led, ny);
+    uint16_t blue_pwm = axis_map(&map_led, nx);
     
-    // Configuração do ADC
-    adc_init();
-    adc_gpio_init(VRX_PIN);
-    adc_gpio_init(VRY_PIN);
+    // Cálculo da nova posição do quadrado baseado no joystick
+    square_x = axis_map(&map_square_x, ny);
+    square_y = axis_map(&map_square_y, nx);
+    TRACE_STAMP(&trace, TRACE_MAP);
 
-    // Configuração das GPIOs
-    gpio_init(SW_PIN);
-    gpio_set_dir(SW_PIN, GPIO_IN);
-    gpio_pull_up(SW_PIN);
-    gpio_set_irq_enabled_with_callback(SW_PIN, GPIO_IRQ_EDGE_FALL, true, &gpio_callback);
+    // Controle dos LEDs RGB baseado na posição do joystick
+    set_pwm_duty(LED_R_PIN, red_pwm);
+    set_pwm_duty(LED_B_PIN, blue_pwm);
+    TRACE_STAMP(&trace, TRACE_PWM);
+
+    // Publica o estado para o display sem esperar pelo consumidor
+    render_state_t *state = &render_slots[triple_buffer_write_slot(&render_buffer)];
+    state->square_x = square_x;
+    state->square_y = square_y;
+    state->border_style = border_style;
+    state->overlay = overlay_enabled;
+#if LATENCY_TRACE
+    state->trace = trace;
+#endif
+    triple_buffer_publish(&render_buffer);
+}
 
-    gpio_init(BUTTON_A_PIN);
-    gpio_set_dir(BUTTON_A_PIN, GPIO_IN);
-    gpio_pull_up(BUTTON_A_PIN);
-    gpio_set_irq_enabled_with_callback(BUTTON_A_PIN, GPIO_IRQ_EDGE_FALL, true, &gpio_callback);
+uint32_t loop_overruns(void) {
+    // Execuções de tarefa perdidas; um tick pulado já conta em cada tarefa
+    // devida nele, então late_ticks não entra na soma
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < scheduler.count; ++i)
+        total += scheduler.tasks[i].overruns;
+    return total;
+}
 
-    gpio_init(LED_G_PIN);
-    gpio_set_dir(LED_G_PIN, GPIO_OUT);
+void render_frame(void) {
+    // Sem estado novo desde o último quadro não há o que redesenhar
+    uint8_t slot;
+    if (!triple_buffer_acquire(&render_buffer, &slot))
+        return;
+    const render_state_t *state = &render_slots[slot];
+    uint32_t render_start = hal_time_us();
+
+    // Atualização do Display OLED
+    ssd1306_fill(&ssd, false);
+    // Desenha quadrado 8x8 pixels na posição calculada
+    ssd1306_rect(&ssd, state->square_y, state->square_x, 8, 8, true, true);
+    draw_border(&ssd, state->border_style);
+    if (state->overlay)
+        frame_profiler_draw(&profiler, &ssd, OVERLAY_X, OVERLAY_PAGE);
+    uint32_t render_end = hal_time_us();
+#if LATENCY_TRACE
+    frame_trace = state->trace;
+#endif
+    TRACE_STAMP(&frame_trace, TRACE_RENDER);
+    // Envia por DMA apenas as colunas que mudaram em relação ao último
+    // quadro; o próximo quadro é desenhado enquanto este é transmitido
+    bus_start_us = hal_time_us();
+    ssd1306_send_diff_async(&ssd);
+    // Quadro sem mudanças não gera transferência nem entra nas estatísticas
+    if (ssd.async_busy)
+        TRACE_STAMP(&frame_trace, TRACE_I2C_START);
+#if HAL_HOST
+    // Tempo de barramento no host: estimativa do painel emulado a 400 kHz
+    ssd1306_emu_end_frame(&panel, &panel_frame);
+    if (panel_frame.bytes)
+        frame_profiler_bus(&profiler, ssd1306_bus_time_us(&panel_frame, 400000));
+#endif
+    frame_profiler_frame(&profiler, render_end - render_start, loop_overruns(), render_end);
+}
+
+void display_transfer_done(ssd1306_t *ssd, void *user) {
+    // Chamado por ssd1306_busy/ssd1306_wait ao detectar o fim da transferência.
+    // No host a transferência é instantânea; o tempo de barramento vem da
+    // estimativa do painel emulado em render_frame
+#if !HAL_HOST
+    frame_profiler_bus(&profiler, hal_time_us() - bus_start_us);
+#endif
+    TRACE_STAMP(&frame_trace, TRACE_I2C_END);
+#if LATENCY_TRACE
+    latency_trace_commit(&latency_trace, &frame_trace);
+#endif
+}
+
+#if HAL_HOST
+void panel_dump(void) {
+    // Imagem do painel emulado e custo no barramento do último quadro
+    const ssd1306_bus_stats_t *f = &panel_frame;
+    printf("quadro: %lu transacoes, %lu bytes (%lu de dados)\n",
+           (unsigned long)f->transactions, (unsigned long)f->bytes, (unsigned long)f->data_bytes);
+    printf("fio: %lu us a 100k, %lu us a 400k, %lu us a 1M\n",
+           (unsigned long)ssd1306_bus_time_us(f, 100000),
+           (unsigned long)ssd1306_bus_time_us(f, 400000),
+           (unsigned long)ssd1306_bus_time_us(f, 1000000));
+    if (panel.frames)
+        printf("media: %lu bytes por quadro em %lu quadros\n",
+               (unsigned long)(panel.total.bytes / panel.frames), (unsigned long)panel.frames);
+    if (ssd1306_emu_write_pbm(&panel, "frame.pbm"))
+        printf("imagem em frame.pbm\n");
+}
+#endif
+
+void console_poll(void) {
+    // Comandos pelo console: 'c' liga/desliga a captura das entradas, 'o' a
+    // sobreposição de desempenho, 't' imprime as latências, 'r' zera as
+    // estatísticas e, no host, 'p' grava a tela emulada
+    int c = hal_console_getc();
+    if (c == 'c')
+        capture_requested = !capture_requested;
+    else if (c == 'o')
+        overlay_enabled = !overlay_enabled;
+#if LATENCY_TRACE
+    if (c == 't')
+        latency_trace_dump(&latency_trace);
+    else if (c == 'r')
+        latency_trace_reset(&latency_trace);
+#endif
+#if HAL_HOST
+    if (c == 'p')
+        panel_dump();
+#endif
+    (void)c;
+}
+
+void display_task(void *user) {
+    // Com o quadro anterior ainda em transmissão este quadro é pulado, para
+    // não bloquear a tarefa de entrada
+    if (!ssd1306_busy(&ssd))
+        render_frame();
+    console_poll();
+}
+
+void display_poll_task(void *user) {
+    // Detecta o fim da transferência com a resolução do tick
+    ssd1306_busy(&ssd);
+}
+
+void core1_main(void) {
+    // O núcleo 1 é dono do display e do I2C: pode esperar a transmissão
+    // anterior sem atrasar a entrada, que roda no núcleo 0
+    uint32_t next = hal_time_us();
+    while (true) {
+        next += DISPLAY_PERIOD * TICK_US;
+        hal_sleep_until_us(next);
+        render_frame();
+        // Espera o fim da transferência aqui para marcar TRACE_I2C_END no
+        // instante certo; o núcleo 1 não tem mais nada a fazer até o próximo quadro
+        ssd1306_wait(&ssd);
+        console_poll();
+    }
+}
+
+// ======= Inicialização e Laço =======
+void app_setup(void) {
+    // Configuração do ADC
+    hal_adc_init(VRX_PIN);
+    hal_adc_init(VRY_PIN);
+    joystick_init(&joystick, JOYSTICK_SAMPLE_RATE);
+    joystick_filter_init(&joystick_filter, &JOYSTICK_FILTER);
+    joystick_start(&joystick);
+
+    // Configuração das GPIOs
+    event_queue_init(&input_events);
+    hal_gpio_input_pullup(SW_PIN);
+    hal_gpio_input_pullup(BUTTON_A_PIN);
+    hal_gpio_output(LED_G_PIN);
 
     // Configuração do PWM para os LEDs RGB
     init_pwm(LED_R_PIN);
     init_pwm(LED_B_PIN);
 
     // Configuração I2C e Display OLED
-    i2c_init(I2C_PORT, 400 * 1000);
-    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
-    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C_SDA);
-    gpio_pull_up(I2C_SCL);
+    hal_i2c_t *i2c = hal_i2c_init(I2C_PORT, 400 * 1000, I2C_SDA, I2C_SCL);
+#if HAL_HOST
+    ssd1306_emu_init(&panel, ENDERECO);
+    hal_host_set_i2c_sink(ssd1306_emu_i2c_sink, &panel);
+#endif
 
-    ssd1306_init(&ssd, WIDTH, HEIGHT, false, ENDERECO, I2C_PORT);
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, ENDERECO, i2c);
     ssd1306_config(&ssd);
+#if HAL_HOST
+    // As palavras da transferência assíncrona vão direto ao painel emulado
+    ssd1306_set_async_backend(&ssd, ssd1306_emu_async_backend(&panel));
+#else
+    ssd1306_set_async_backend(&ssd, ssd1306_dma_init(&ssd_dma, i2c));
+#endif
     ssd1306_fill(&ssd, false);
     ssd1306_send_data(&ssd);
 
-    // Loop Principal
-    while (true) {
-        // Leitura dos valores do Joystick
-        adc_select_input(0);
-        uint16_t vrx_value = adc_read();
-        adc_select_input(1);
-        uint16_t vry_value = adc_read();
-        
-        // Controle dos LEDs RGB baseado na posição do joystick
-        uint16_t red_pwm = 0;
-        uint16_t blue_pwm = 0;
-        
-        // Zona morta de 150 para evitar flutuações quando joystick está próximo do centro
-        if (abs(vrx_value - JOYSTICK_CENTER) > 150) {
-            // Multiplica por 32 para converter range do ADC para PWM
-            blue_pwm = abs(vrx_value - JOYSTICK_CENTER) * 32;
-        }
-        if (abs(vry_value - JOYSTICK_CENTER) > 150) {
-            red_pwm = abs(vry_value - JOYSTICK_CENTER) * 32;
+    // Calibração: com o botão do joystick pressionado no boot faz a
+    // calibração completa e grava na flash; sem calibração gravada aprende
+    // só o centro, assumindo o joystick solto
+    axis_map_init(&map_square_x, &MAP_SQUARE_X);
+    axis_map_init(&map_square_y, &MAP_SQUARE_Y);
+    axis_map_init(&map_led, &MAP_LED);
+    axis_map_hw_init();
+
+    calibration_default(&calibration);
+    if (!hal_gpio_get(SW_PIN)) {
+        joystick_calibrate(true);
+        calibration_save(&calibration);
+    } else if (!calibration_load(&calibration)) {
+        joystick_calibrate(false);
+    }
+
+    // Amostragem dos botões a partir do nível atual: um botão ainda
+    // pressionado desde o boot não gera evento de pressionar
+    gesture_init(&sw_gesture, &SW_GESTURES);
+    gesture_init(&button_a_gesture, &BUTTON_A_GESTURES);
+    debounce_init(&buttons, BUTTON_MASK, hal_gpio_get_all(), BUTTON_SAMPLE_US, BUTTON_SETTLE_US);
+    hal_timer_start(&button_timer, BUTTON_SAMPLE_US, button_timer_callback, NULL);
+
+    // Entrada e PWM a 1 kHz, independentes da taxa do display
+    scheduler_init(&scheduler, TICK_US, NULL);
+    scheduler_add(&scheduler, input_task, NULL, INPUT_PERIOD, 0);
+    triple_buffer_init(&render_buffer);
+    render_slots[0] = (render_state_t){ .square_x = square_x, .square_y = square_y, .border_style = border_style };
+    frame_profiler_init(&profiler, PROFILER_WINDOW_US, hal_time_us());
+    ssd1306_set_async_callback(&ssd, display_transfer_done, NULL);
+#if LATENCY_TRACE
+    latency_trace_reset(&latency_trace);
+#endif
+#if DUAL_CORE
+    multicore_launch_core1(core1_main);
+#else
+    scheduler_add(&scheduler, display_task, NULL, DISPLAY_PERIOD, 0);
+    scheduler_add(&scheduler, display_poll_task, NULL, 1, 0);
+#endif
+    scheduler_start(&scheduler);
+}
+
+void app_step(void) {
+    // Dorme até o próximo tick do timer e executa as tarefas devidas
+    scheduler_wait(&scheduler);
+    scheduler_poll(&scheduler);
+}
+
+#if HAL_HOST
+// ======= Reprodução de Traces (host) =======
+void replay_apply(const input_trace_record_t *record) {
+    // Entradas do registro: ADC0/ADC1 e botões com pull-up (nível baixo
+    // pressionado), amostrados pelos timers como no hardware
+    hal_host_set_adc(0, record->x);
+    hal_host_set_adc(1, record->y);
+    hal_host_set_gpio(SW_PIN, !(record->buttons & INPUT_TRACE_SW));
+    hal_host_set_gpio(BUTTON_A_PIN, !(record->buttons & INPUT_TRACE_BUTTON_A));
+}
+
+uint32_t panel_hash(void) {
+    // FNV-1a da GDDRAM emulada, para comparar sequências de quadros
+    uint32_t hash = 2166136261u;
+    const uint8_t *p = &panel.gddram[0][0];
+    for (size_t i = 0; i < sizeof(panel.gddram); ++i)
+        hash = (hash ^ p[i]) * 16777619u;
+    return hash;
+}
+
+int replay_run(const char *trace_path, const char *out_dir) {
+    // Reproduz um trace com relógio virtual: cada registro é aplicado no seu
+    // instante e o laço roda tick a tick entre registros. Com out_dir grava
+    // pwm.csv (mudanças dos LEDs), frames.csv (tráfego e hash de cada
+    // quadro) e a imagem de cada quadro como frame_NNNNN.pbm
+    input_trace_file_t trace;
+    input_trace_record_t record;
+    if (!input_trace_open(&trace, trace_path)) {
+        fprintf(stderr, "%s: nao foi possivel abrir\n", trace_path);
+        return 1;
+    }
+    if (!input_trace_read(&trace, &record)) {
+        fprintf(stderr, "%s: trace vazio ou invalido\n", trace_path);
+        input_trace_close(&trace);
+        return 1;
+    }
+
+    FILE *pwm_log = NULL, *frame_log = NULL;
+    char path[512];
+    if (out_dir) {
+        snprintf(path, sizeof(path), "%s/pwm.csv", out_dir);
+        pwm_log = fopen(path, "w");
+        snprintf(path, sizeof(path), "%s/frames.csv", out_dir);
+        frame_log = fopen(path, "w");
+        if (!pwm_log || !frame_log) {
+            fprintf(stderr, "%s: nao foi possivel criar as saidas\n", out_dir);
+            if (pwm_log)
+                fclose(pwm_log);
+            if (frame_log)
+                fclose(frame_log);
+            input_trace_close(&trace);
+            return 1;
         }
+        fprintf(pwm_log, "tempo_us,vermelho,verde,azul\n");
+        fprintf(frame_log, "tempo_us,quadro,bytes,bytes_dados,fio_400k_us,hash\n");
+    }
 
-        set_pwm_duty(LED_R_PIN, red_pwm);
-        set_pwm_duty(LED_B_PIN, blue_pwm);
-        
-        // Cálculo da nova posição do quadrado baseado no joystick
-        // 60 e 28 são posições iniciais, 114 e 50 são limites de movimento
-        square_x = 60 + ((vry_value - JOYSTICK_CENTER) * 114) / ADC_MAX;
-        square_y = 28 - ((vrx_value - JOYSTICK_CENTER) * 50) / ADC_MAX;
+    // A inicialização (e a calibração do centro, sem calibração gravada)
+    // vê as entradas do primeiro registro
+    hal_host_set_virtual_clock(true);
+    replay_apply(&record);
+    app_setup();
+    // O tráfego da inicialização não conta como quadro
+    ssd1306_emu_end_frame(&panel, NULL);
 
-        // Atualização do Display OLED
-        ssd1306_fill(&ssd, false);
-        // Desenha quadrado 8x8 pixels na posição calculada
-        ssd1306_rect(&ssd, square_y, square_x, 8, 8, true, true);
-        draw_border(&ssd, border_style);
-        ssd1306_send_data(&ssd);
+    uint32_t origin = hal_time_us();
+    uint32_t first_frame = panel.frames, records = 0, frames = 0, frame_bytes = 0, last_us = 0;
+    uint16_t red = 0, blue = 0;
+    bool green = false, logged = false;
+    struct timespec wall_start, wall_end;
+    timespec_get(&wall_start, TIME_UTC);
+
+    bool more = true;
+    while (more || (int32_t)(hal_time_us() - origin - last_us) < REPLAY_TAIL_US) {
+        if (more && (int32_t)(hal_time_us() - origin - record.time_us) >= 0) {
+            replay_apply(&record);
+            records++;
+            last_us = record.time_us;
+            more = input_trace_read(&trace, &record);
+            continue;
+        }
+        app_step();
 
-        sleep_ms(20);  // Delay para controle de taxa de atualização
+        uint32_t now = hal_time_us() - origin;
+        uint16_t r = hal_host_pwm_level(LED_R_PIN), b = hal_host_pwm_level(LED_B_PIN);
+        bool g = hal_host_gpio_output(LED_G_PIN);
+        if (!logged || r != red || g != green || b != blue) {
+            red = r, green = g, blue = b, logged = true;
+            if (pwm_log)
+                fprintf(pwm_log, "%lu,%u,%u,%u\n", (unsigned long)now, red, green, blue);
+        }
+        while (first_frame + frames < panel.frames) {
+            // Um quadro por passo do display; o tráfego está em panel_frame
+            frames++;
+            frame_bytes += panel_frame.bytes;
+            if (frame_log)
+                fprintf(frame_log, "%lu,%lu,%lu,%lu,%lu,%08lx\n", (unsigned long)now, (unsigned long)frames,
+                        (unsigned long)panel_frame.bytes, (unsigned long)panel_frame.data_bytes,
+                        (unsigned long)ssd1306_bus_time_us(&panel_frame, 400000), (unsigned long)panel_hash());
+            if (out_dir) {
+                snprintf(path, sizeof(path), "%s/frame_%05lu.pbm", out_dir, (unsigned long)frames);
+                ssd1306_emu_write_pbm(&panel, path);
+            }
+        }
     }
+    timespec_get(&wall_end, TIME_UTC);
+    if (trace.error)
+        fprintf(stderr, "%s:%lu: registro invalido\n", trace_path, (unsigned long)trace.line);
+    input_trace_close(&trace);
+    if (pwm_log)
+        fclose(pwm_log);
+    if (frame_log)
+        fclose(frame_log);
+
+    double wall_us = (wall_end.tv_sec - wall_start.tv_sec) * 1e6 + (wall_end.tv_nsec - wall_start.tv_nsec) / 1e3;
+    double sim_us = (double)(hal_time_us() - origin);
+    printf("%lu registros, %.3f s simulados em %.3f s (%.0fx)\n", (unsigned long)records,
+           sim_us / 1e6, wall_us / 1e6, wall_us > 0 ? sim_us / wall_us : 0.0);
+    if (frames)
+        printf("%lu quadros, %.1f us reais e %lu bytes no barramento por quadro\n", (unsigned long)frames,
+               wall_us / frames, (unsigned long)(frame_bytes / frames));
+    if (panel.framing_errors)
+        fprintf(stderr, "%lu erros de enquadramento RESTART/STOP no barramento\n",
+                (unsigned long)panel.framing_errors);
+    return trace.error || panel.framing_errors ? 1 : 0;
+}
+#endif
+
+// ======= Função Principal =======
+int main(int argc, char **argv) {
+    // Inicializações básicas
+    hal_init();
+#if HAL_HOST
+    // No host, AtividadeADC_host <trace> [pasta] reproduz um trace gravado
+    // ou escrito a mão (ver input_trace.h) em vez de rodar interativo
+    if (argc > 1)
+        return replay_run(argv[1], argc > 2 ? argv[2] : NULL);
+#endif
+    app_setup();
+
+    // Loop Principal
+    while (true)
+        app_step();
 
     return 0;
 }
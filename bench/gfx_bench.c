@@ -0,0 +1,233 @@
+/**
+ * Microbenchmarks das primitivas de desenho do ssd1306
+ * Mede cada primitiva em tamanhos e posições representativos, só no
+ * framebuffer (sem I2C). No host o tempo vem do relógio monotônico (ns);
+ * no Pico, do SysTick contando ciclos do processador.
+ *
+ * Saída em CSV, uma linha "bench,..." por caso, lida por tools/gfxbench.py
+ * para gravar uma referência e acusar regressões.
+ */
+
+#if HAL_HOST
+#define _POSIX_C_SOURCE 200809L     // clock_gettime
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "inc/hal.h"
+#include "inc/ssd1306.h"
+#include "inc/border.h"
+#include "inc/frame_profiler.h"
+#include "inc/app_config.h"
+
+#if HAL_HOST
+#include <time.h>
+#else
+#include "hardware/structs/systick.h"
+#endif
+
+// ======= Relógio =======
+#if HAL_HOST
+#define BENCH_UNIT "ns"
+#define BENCH_MASK 0xFFFFFFFFu
+#define BENCH_BATCH 5000000u        // Duração mínima de cada lote (5 ms)
+
+static void bench_clock_init(void) {
+}
+
+static uint32_t bench_now(void) {
+    // Relógio monotônico: não salta com ajustes da hora do sistema
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+#else
+#define BENCH_UNIT "ciclos"
+#define BENCH_MASK 0xFFFFFFu        // SysTick de 24 bits
+#define BENCH_BATCH 1000000u        // ~8 ms a 125 MHz, longe da volta do contador
+
+static void bench_clock_init(void) {
+    // Clock do processador, sem interrupção, recarga máxima
+    systick_hw->csr = 0;
+    systick_hw->rvr = BENCH_MASK;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;
+}
+
+static uint32_t bench_now(void) {
+    // O SysTick conta para baixo
+    return BENCH_MASK - systick_hw->cvr;
+}
+#endif
+
+#define BENCH_REPEATS 7             // Lotes por caso; vale o mais rápido
+
+// ======= Casos =======
+typedef enum {
+    OP_NONE,
+    OP_FILL,
+    OP_RECT,
+    OP_LINE,
+    OP_STRING,
+    OP_TEXT,
+    OP_BORDER,
+    OP_FRAME,
+    OP_OVERLAY,
+} bench_op_t;
+
+typedef struct {
+    const char *primitive;
+    const char *name;
+    bench_op_t op;
+    int16_t a, b, c, d;             // Posição/tamanho, extremos da linha ou estilo
+    bool value;                     // Cor, ou preenchimento em OP_RECT
+    const char *text;
+    const font_t *font;
+} bench_case_t;
+
+static const bench_case_t CASES[] = {
+    { "fill", "apaga", OP_FILL, .value = false },
+    { "fill", "acende", OP_FILL, .value = true },
+    { "rect", "8x8_cheio", OP_RECT, 28, 60, 8, 8, true },
+    { "rect", "8x8_cheio_desalinhado", OP_RECT, 29, 61, 8, 8, true },
+    { "rect", "32x16_cheio", OP_RECT, 24, 48, 32, 16, true },
+    { "rect", "tela_cheio", OP_RECT, 0, 0, WIDTH, HEIGHT, true },
+    { "rect", "8x8_contorno", OP_RECT, 28, 60, 8, 8, false },
+    { "rect", "tela_contorno", OP_RECT, 0, 0, WIDTH, HEIGHT, false },
+    { "line", "horizontal_128", OP_LINE, 0, 31, WIDTH - 1, 31 },
+    { "line", "vertical_64", OP_LINE, 63, 0, 63, HEIGHT - 1 },
+    { "line", "diagonal_45", OP_LINE, 0, 0, HEIGHT - 1, HEIGHT - 1 },
+    { "line", "diagonal_tela", OP_LINE, 0, 0, WIDTH - 1, HEIGHT - 1 },
+    { "line", "curta_8", OP_LINE, 10, 10, 17, 13 },
+    { "draw_string", "1_char", OP_STRING, 60, 24, .text = "A" },
+    { "draw_string", "10_chars", OP_STRING, 24, 20, .text = "CALIBRANDO" },
+    { "draw_string", "10_chars_desalinhado", OP_STRING, 24, 21, .text = "CALIBRANDO" },
+    { "draw_string", "15_chars", OP_STRING, 0, 48, .text = "ABCDEFGHIJKLMNO" },
+    { "draw_text", "5x7_11_chars", OP_TEXT, 0, 0, .text = "Hello world", .font = &font_5x7 },
+    { "draw_text", "5x7_x2_5_chars", OP_TEXT, 0, 24, .text = "12345", .font = &font_5x7_x2 },
+    { "draw_border", "simples", OP_BORDER, 0 },
+    { "draw_border", "dupla", OP_BORDER, 1 },
+    { "draw_border", "cantos", OP_BORDER, 2 },
+    { "frame", "quadro_app", OP_FRAME, 28, 60, 1 },
+    { "frame", "quadro_app_sobreposicao", OP_OVERLAY, 28, 60, 1 },
+};
+
+static ssd1306_t ssd;
+static frame_profiler_t profiler;
+
+static void bench_run_case(const bench_case_t *c) {
+    switch (c->op) {
+        case OP_NONE:
+            break;
+        case OP_FILL:
+            ssd1306_fill(&ssd, c->value);
+            break;
+        case OP_RECT:
+            ssd1306_rect(&ssd, c->a, c->b, c->c, c->d, true, c->value);
+            break;
+        case OP_LINE:
+            ssd1306_line(&ssd, c->a, c->b, c->c, c->d, true);
+            break;
+        case OP_STRING:
+            ssd1306_draw_string(&ssd, c->text, c->a, c->b);
+            break;
+        case OP_TEXT:
+            ssd1306_draw_text(&ssd, c->font, c->text, c->a, c->b);
+            break;
+        case OP_BORDER:
+            draw_border(&ssd, c->a);
+            break;
+        case OP_FRAME:
+            // O que render_frame desenha a cada quadro
+            ssd1306_fill(&ssd, false);
+            ssd1306_rect(&ssd, c->a, c->b, 8, 8, true, true);
+            draw_border(&ssd, c->c);
+            break;
+        case OP_OVERLAY:
+            // Quadro com a sobreposição de desempenho; o texto só é
+            // redesenhado quando a janela fecha, então mede-se a cópia do bloco
+            ssd1306_fill(&ssd, false);
+            ssd1306_rect(&ssd, c->a, c->b, 8, 8, true, true);
+            draw_border(&ssd, c->c);
+            frame_profiler_draw(&profiler, &ssd, OVERLAY_X, OVERLAY_PAGE);
+            break;
+    }
+}
+
+// Pixels alterados por uma chamada: acesos sobre a tela apagada ou, se
+// nenhum, apagados sobre a tela acesa
+static uint32_t bench_pixels(const bench_case_t *c) {
+    uint32_t count = 0;
+    for (int pass = 0; pass < 2 && !count; ++pass) {
+        uint8_t background = pass ? 0xFF : 0x00;
+        memset(ssd.ram_buffer + 1, background, ssd.bufsize - 1);
+        bench_run_case(c);
+        for (size_t i = 1; i < ssd.bufsize; ++i)
+            count += __builtin_popcount((uint8_t)(ssd.ram_buffer[i] ^ background));
+    }
+    return count;
+}
+
+// Menor tempo de um lote de n chamadas entre BENCH_REPEATS lotes
+static uint32_t bench_batch(const bench_case_t *c, uint32_t n) {
+    uint32_t best = BENCH_MASK;
+    for (int r = 0; r < BENCH_REPEATS; ++r) {
+        uint32_t start = bench_now();
+        for (uint32_t i = 0; i < n; ++i)
+            bench_run_case(c);
+        uint32_t elapsed = (bench_now() - start) & BENCH_MASK;
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return best;
+}
+
+// Dobra o lote até durar BENCH_BATCH; devolve o custo por chamada em
+// milésimos da unidade
+static uint64_t bench_measure(const bench_case_t *c, uint32_t *iterations) {
+    uint32_t n = 1, elapsed;
+    while ((elapsed = bench_batch(c, n)) < BENCH_BATCH && n < (1u << 24))
+        n <<= 1;
+    *iterations = n;
+    return (uint64_t)elapsed * 1000u / n;
+}
+
+static void bench_run_all(void) {
+    // O laço e a chamada indireta vazia são descontados de cada caso
+    static const bench_case_t empty = { "none", "vazio", OP_NONE };
+    uint32_t iterations;
+    uint64_t overhead = bench_measure(&empty, &iterations);
+
+    printf("bench,primitiva,caso,pixels,iteracoes,por_chamada,por_pixel,unidade\n");
+    for (size_t i = 0; i < count_of(CASES); ++i) {
+        const bench_case_t *c = &CASES[i];
+        uint32_t pixels = bench_pixels(c);
+        uint64_t cost = bench_measure(c, &iterations);
+        cost = cost > overhead ? cost - overhead : 0;
+        printf("bench,%s,%s,%lu,%lu,%lu.%03lu,%lu.%03lu,%s\n", c->primitive, c->name,
+               (unsigned long)pixels, (unsigned long)iterations,
+               (unsigned long)(cost / 1000), (unsigned long)(cost % 1000),
+               (unsigned long)(pixels ? cost / pixels / 1000 : 0),
+               (unsigned long)(pixels ? cost / pixels % 1000 : 0), BENCH_UNIT);
+    }
+}
+
+int main() {
+    hal_init();
+    bench_clock_init();
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, NULL);
+    frame_profiler_init(&profiler, 1000000, 0);
+
+#if HAL_HOST
+    bench_run_all();
+    return 0;
+#else
+    // No Pico a saída vai pelo USB: roda ao ligar e de novo a cada tecla
+    while (true) {
+        hal_sleep_ms(2000);
+        bench_run_all();
+        while (hal_console_getc() < 0)
+            hal_sleep_ms(10);
+    }
+#endif
+}
@@ -0,0 +1,68 @@
+#ifndef APP_CONFIG_H
+#define APP_CONFIG_H
+
+#include "border.h"
+#include "frame_profiler.h"
+#include "calibration.h"
+#include "axis_map.h"
+#include "axis_filter.h"
+#include "gesture.h"
+
+// Parametros da aplicacao compartilhados com bench/ e tests/, para que estes
+// mecam e verifiquem exatamente o que o firmware desenha e calcula
+
+// Sobreposicao do frame_profiler no canto superior esquerdo, entre a linha
+// interna da borda dupla (x = 2, y = 2) e o restante da tela: colunas 3..66,
+// paginas 1..2 (y = 8..23). Nenhum estilo de borda desenha nessa area.
+#define OVERLAY_X 3
+#define OVERLAY_PAGE 1
+
+#define JOYSTICK_SAMPLE_RATE 10000  // Pares X/Y amostrados por segundo
+#define BUTTON_SAMPLE_US 1000       // Amostragem dos botoes
+#define BUTTON_SETTLE_US 5000       // Tempo estavel para aceitar uma mudanca
+#define PWM_MAX 65535               // Valor maximo do PWM de 16 bits (2^16 - 1)
+
+// Mapeamentos da posicao normalizada do joystick: 60 e 28 sao as posicoes
+// iniciais do quadrado, +-57 e +-25 seus limites de movimento; os LEDs usam
+// o afastamento do centro em qualquer direcao
+static const axis_map_config_t MAP_SQUARE_X = {
+  .mode = AXIS_MAP_LINEAR,
+  .in_min = -CALIBRATION_FULL, .in_max = CALIBRATION_FULL,
+  .out_min = 60 - 57, .out_max = 60 + 57,
+};
+static const axis_map_config_t MAP_SQUARE_Y = {
+  .mode = AXIS_MAP_LINEAR,
+  .in_min = -CALIBRATION_FULL, .in_max = CALIBRATION_FULL,
+  .out_min = 28 + 25, .out_max = 28 - 25,
+};
+static const axis_map_config_t MAP_LED = {
+  .mode = AXIS_MAP_MAGNITUDE,
+  .in_min = -CALIBRATION_FULL, .in_max = CALIBRATION_FULL,
+  .out_min = 0, .out_max = PWM_MAX,
+};
+
+// Filtro dos eixos: media de 16 amostras (625 Hz de saida) seguida de um
+// one-euro com corte de 2 Hz em repouso que sobe com a velocidade do eixo
+static const axis_filter_config_t JOYSTICK_FILTER = {
+  .decimation_log2 = 4,
+  .input_rate = JOYSTICK_SAMPLE_RATE,
+  .min_cutoff_q8 = 2 << 8,
+  .beta_q24 = 4096,
+  .d_cutoff_q8 = 1 << 8,
+};
+
+// Tempos dos gestos: os dois botoes aceitam duplo clique (no botao A, com
+// janela curta para o clique continuar agil) e segurar o botao A repete o
+// ajuste de brilho
+static const gesture_config_t SW_GESTURES = {
+  .double_click_us = 300000,
+  .long_press_us = 600000,
+  .repeat_us = 0,
+};
+static const gesture_config_t BUTTON_A_GESTURES = {
+  .double_click_us = 250000,
+  .long_press_us = 600000,
+  .repeat_us = 400000,
+};
+
+#endif
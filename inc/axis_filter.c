@@ -0,0 +1,86 @@
+#include <string.h>
+#include "axis_filter.h"
+
+// 2*pi em Q12
+#define TWO_PI_Q12 25736u
+
+// Coeficiente do IIR de um polo, alpha = 1 / (1 + rate / (2*pi*fc)), em Q16.
+// Roda a cada saida: 2*pi*fc fica em Q12 para cortes baixos nao perderem
+// precisao, e numerador e denominador sao reduzidos ate caberem em 32 bits
+// para a divisao usar o divisor do RP2040 (a de 64 bits e em software)
+static uint32_t axis_filter_alpha(uint32_t cutoff_q8, uint32_t rate) {
+  uint64_t w_q12 = ((uint64_t)cutoff_q8 * TWO_PI_Q12) >> 8;
+  uint64_t den = w_q12 + ((uint64_t)rate << 12);
+  while (w_q12 >= 1u << 16 || den >> 32) {
+    w_q12 >>= 1;
+    den >>= 1;
+  }
+  return ((uint32_t)w_q12 << 16) / (uint32_t)den;
+}
+
+void axis_filter_init(axis_filter_t *f, const axis_filter_config_t *config) {
+  memset(f, 0, sizeof(*f));
+  f->config = *config;
+  f->output_rate = config->input_rate >> config->decimation_log2;
+  if (!f->output_rate)
+    f->output_rate = 1;
+  f->alpha_d_q16 = axis_filter_alpha(config->d_cutoff_q8, f->output_rate);
+  // Meio da escala ate a primeira saida, para nao indicar um eixo no extremo
+  f->value_q8 = 32768 << 8;
+}
+
+// Estagio one-euro sobre uma saida da decimacao
+static void axis_filter_smooth(axis_filter_t *f, int32_t x) {
+  if (!f->primed || !f->config.min_cutoff_q8) {
+    f->primed = true;
+    f->last = x;
+    f->value_q8 = x << 8;
+    return;
+  }
+
+  int32_t cutoff_q8 = f->config.min_cutoff_q8;
+  if (f->config.beta_q24) {
+    int64_t dx = (int64_t)(x - f->last) * f->output_rate;
+    f->speed += (int32_t)(((dx - f->speed) * f->alpha_d_q16) >> 16);
+    uint32_t speed = f->speed < 0 ? -f->speed : f->speed;
+    uint64_t boost = ((uint64_t)speed * f->config.beta_q24) >> 16;
+    // Limita o corte a taxa de saida (alpha ~ 0.86); acima disso nao ha filtragem util
+    uint64_t max_q8 = (uint64_t)f->output_rate << 8;
+    uint64_t c = cutoff_q8 + boost;
+    cutoff_q8 = (int32_t)(c > max_q8 ? max_q8 : c);
+  }
+  f->last = x;
+
+  uint32_t alpha = axis_filter_alpha(cutoff_q8, f->output_rate);
+  f->value_q8 += (int32_t)(((int64_t)((x << 8) - f->value_q8) * alpha) >> 16);
+}
+
+// Acrescenta uma amostra de 12 bits; true quando uma nova saida foi produzida
+bool axis_filter_push(axis_filter_t *f, uint16_t sample) {
+  f->acc += sample;
+  if (++f->count < (1u << f->config.decimation_log2))
+    return false;
+
+  // Soma de 2^k amostras de 12 bits normalizada para 16 bits
+  uint8_t k = f->config.decimation_log2;
+  int32_t x = (int32_t)(k >= 4 ? f->acc >> (k - 4) : f->acc << (4 - k));
+  f->acc = 0;
+  f->count = 0;
+  axis_filter_smooth(f, x);
+  return true;
+}
+
+void joystick_filter_init(joystick_filter_t *jf, const axis_filter_config_t *config) {
+  axis_filter_init(&jf->x, config);
+  axis_filter_init(&jf->y, config);
+}
+
+// Processa um bloco de pares X/Y; true se alguma saida nova foi produzida
+bool joystick_filter_process(joystick_filter_t *jf, const joystick_sample_t *samples, size_t count) {
+  bool updated = false;
+  for (size_t i = 0; i < count; ++i) {
+    updated |= axis_filter_push(&jf->x, samples[i].x);
+    axis_filter_push(&jf->y, samples[i].y);
+  }
+  return updated;
+}
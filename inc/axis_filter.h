@@ -0,0 +1,50 @@
+#ifndef AXIS_FILTER_H
+#define AXIS_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "sample_ring.h"
+
+// Filtro de um eixo em ponto fixo (sem ponto flutuante):
+//  1. decimacao boxcar (CIC de 1a ordem): soma 2^decimation_log2 amostras de
+//     12 bits e normaliza para 16 bits, ganhando resolucao com a sobreamostragem;
+//  2. filtro one-euro opcional na taxa de saida: IIR de um polo cujo corte
+//     sobe de min_cutoff com a velocidade do eixo (beta = 0 da um IIR fixo).
+typedef struct {
+  uint8_t decimation_log2;  // Amostras somadas por saida = 2^decimation_log2
+  uint32_t input_rate;      // Amostras por segundo na entrada
+  uint32_t min_cutoff_q8;   // Corte minimo em Hz (Q8.8); 0 desativa o IIR
+  uint32_t beta_q24;        // Aumento do corte, em Hz por (unidade/s), Q8.24
+  uint32_t d_cutoff_q8;     // Corte do filtro da derivada em Hz (Q8.8)
+} axis_filter_config_t;
+
+typedef struct {
+  axis_filter_config_t config;
+  uint32_t output_rate;     // Saidas por segundo
+  uint32_t acc;             // Soma do bloco de decimacao em andamento
+  uint16_t count;
+  bool primed;              // Ja produziu a primeira saida
+  int32_t value_q8;         // Saida filtrada (Q16.8)
+  int32_t last;             // Ultima saida da decimacao (16 bits)
+  int32_t speed;            // Derivada filtrada, unidades de 16 bits por segundo
+  uint32_t alpha_d_q16;     // Coeficiente fixo do filtro da derivada
+} axis_filter_t;
+
+void axis_filter_init(axis_filter_t *f, const axis_filter_config_t *config);
+bool axis_filter_push(axis_filter_t *f, uint16_t sample);
+
+// Valor filtrado na escala de 16 bits (0 a 65520 para a faixa total do ADC)
+static inline uint16_t axis_filter_value(const axis_filter_t *f) {
+  return (uint16_t)((f->value_q8 + 128) >> 8);
+}
+
+// Par de filtros para os dois eixos do joystick
+typedef struct {
+  axis_filter_t x, y;
+} joystick_filter_t;
+
+void joystick_filter_init(joystick_filter_t *jf, const axis_filter_config_t *config);
+bool joystick_filter_process(joystick_filter_t *jf, const joystick_sample_t *samples, size_t count);
+
+#endif
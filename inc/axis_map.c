@@ -0,0 +1,140 @@
+#include "axis_map.h"
+
+// O interpolador so existe no RP2040; no host (ou com AXIS_MAP_USE_INTERP=0)
+// axis_map usa o caminho portavel
+#ifndef AXIS_MAP_USE_INTERP
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#define AXIS_MAP_USE_INTERP 1
+#else
+#define AXIS_MAP_USE_INTERP 0
+#endif
+#endif
+
+#if AXIS_MAP_USE_INTERP
+#include "hardware/interp.h"
+#endif
+
+#define AXIS_MAP_FULL 32767
+
+// round(32768 * (i / 16)^2), limitado a 32767
+const uint16_t axis_curve_quadratic[AXIS_CURVE_POINTS] = {
+  0, 128, 512, 1152, 2048, 3200, 4608, 6272, 8192,
+  10368, 12800, 15488, 18432, 21632, 25088, 28800, 32767,
+};
+
+// Os divisores so aparecem aqui (no RP2040, no divisor de hardware via
+// pico_divider); a avaliacao usa apenas multiplicacoes e shifts
+void axis_map_init(axis_map_t *map, const axis_map_config_t *config) {
+  int32_t half = (config->in_max - config->in_min) / 2;
+  map->mode = config->mode;
+  map->center = config->in_min + half;
+  map->dead_zone = config->dead_zone;
+  map->span = half > (int32_t)config->dead_zone ? half - config->dead_zone : 1;
+  // u = t * norm_scale >> 16 com t < span nao passa de 32 bits
+  map->norm_scale = ((uint32_t)AXIS_MAP_FULL << 16) / map->span;
+  map->curve = config->curve;
+
+  int32_t range = config->out_max - config->out_min;
+  if (config->mode == AXIS_MAP_LINEAR) {
+    // u em -32767..32767 cobre out_min..out_max; ponto medio com arredondamento
+    map->gain = (uint32_t)(int32_t)(((int64_t)range << 16) / (2 * AXIS_MAP_FULL));
+    map->bias = (uint32_t)(((int64_t)(config->out_min + config->out_max) << 15) + (1 << 15));
+  } else {
+    // u em 0..32767 cobre out_min..out_max
+    map->gain = (uint32_t)(int32_t)(((int64_t)range << 16) / AXIS_MAP_FULL);
+    map->bias = (uint32_t)(((int64_t)config->out_min << 16) + (1 << 15));
+  }
+  map->lo = config->out_min < config->out_max ? config->out_min : config->out_max;
+  map->hi = config->out_min < config->out_max ? config->out_max : config->out_min;
+  map->is_signed = map->lo < 0;
+}
+
+// Magnitude normalizada (0..32767) apos zona morta, sem a curva
+static inline uint32_t axis_map_normalize(const axis_map_t *map, int32_t d) {
+  uint32_t t = d < 0 ? -(uint32_t)d : (uint32_t)d;
+  if (t <= map->dead_zone)
+    return 0;
+  t -= map->dead_zone;
+  return t >= map->span ? AXIS_MAP_FULL : (t * map->norm_scale) >> 16;
+}
+
+// Ganho e deslocamento em aritmetica modular de 32 bits: com |u| <= 32767 e
+// saida de 16 bits os bits 16-31 do acumulador sao exatos mesmo com estouro
+static inline uint32_t axis_map_accum(const axis_map_t *map, int32_t d, uint32_t u) {
+  int32_t s = (map->mode == AXIS_MAP_LINEAR && d < 0) ? -(int32_t)u : (int32_t)u;
+  return (uint32_t)s * map->gain + map->bias;
+}
+
+int32_t axis_map_portable(const axis_map_t *map, int32_t in) {
+  int32_t d = in - map->center;
+  uint32_t u = axis_map_normalize(map, d);
+  if (map->curve && u == AXIS_MAP_FULL) {
+    u = map->curve[AXIS_CURVE_POINTS - 1];
+  } else if (map->curve) {
+    // Interpolacao linear entre pontos, fracao de 8 bits como no modo blend
+    uint32_t i = u >> 11, alpha = (u >> 3) & 0xFF;
+    uint32_t a = map->curve[i], b = map->curve[i + 1];
+    u = a + (((b - a) * alpha) >> 8);
+  }
+
+  uint32_t r = (axis_map_accum(map, d, u) >> 16) & 0xFFFF;
+  int32_t v = map->is_signed ? (int16_t)r : (int32_t)r;
+  return v < map->lo ? map->lo : v > map->hi ? map->hi : v;
+}
+
+#if AXIS_MAP_USE_INTERP
+
+// CTRL_LANE0 do interp1 com e sem sinal; os registradores do SIO nao tem
+// aliases atomicos de set/clear, entao o valor inteiro e reescrito
+static uint32_t clamp_ctrl[2];
+
+// interp0 em modo blend para a curva: PEEK1 = BASE0 + (BASE1 - BASE0) * ACCUM1[7:0] / 256
+// interp1 em modo clamp para a saida: PEEK0 = clamp(ACCUM0 >> 16 com 16 bits, BASE0, BASE1)
+void axis_map_hw_init(void) {
+  interp_config cfg = interp_default_config();
+  interp_config_set_blend(&cfg, true);
+  interp_set_config(interp0, 0, &cfg);
+  cfg = interp_default_config();
+  interp_set_config(interp0, 1, &cfg);
+
+  cfg = interp_default_config();
+  interp_config_set_clamp(&cfg, true);
+  interp_config_set_shift(&cfg, 16);
+  interp_config_set_mask(&cfg, 0, 15);
+  clamp_ctrl[0] = cfg.ctrl;
+  interp_config_set_signed(&cfg, true);
+  clamp_ctrl[1] = cfg.ctrl;
+  interp_set_config(interp1, 0, &cfg);
+}
+
+int32_t axis_map(const axis_map_t *map, int32_t in) {
+  int32_t d = in - map->center;
+  uint32_t u = axis_map_normalize(map, d);
+  if (map->curve && u == AXIS_MAP_FULL) {
+    u = map->curve[AXIS_CURVE_POINTS - 1];
+  } else if (map->curve) {
+    uint32_t i = u >> 11;
+    interp0->base[0] = map->curve[i];
+    interp0->base[1] = map->curve[i + 1];
+    interp0->accum[1] = u >> 3;
+    u = interp_peek_lane_result(interp0, 1);
+  }
+
+  // O sinal da mascara (extensao do bit 15) e da comparacao segue o mapeamento
+  interp1->ctrl[0] = clamp_ctrl[map->is_signed];
+  interp1->base[0] = map->lo;
+  interp1->base[1] = map->hi;
+  interp1->accum[0] = axis_map_accum(map, d, u);
+  return (int32_t)interp_peek_lane_result(interp1, 0);
+}
+
+#else
+
+void axis_map_hw_init(void) {
+}
+
+int32_t axis_map(const axis_map_t *map, int32_t in) {
+  return axis_map_portable(map, in);
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef AXIS_MAP_H
+#define AXIS_MAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Pontos da curva de resposta: valores Q15 para |entrada| = 0, 2048, ..., 32768
+#define AXIS_CURVE_POINTS 17
+
+typedef enum {
+  AXIS_MAP_LINEAR,      // in_min..in_max -> out_min..out_max, com sinal
+  AXIS_MAP_MAGNITUDE,   // |entrada - centro| -> out_min..out_max
+} axis_map_mode_t;
+
+// Mapeamento de eixo declarado como dado. A entrada passa por zona morta em
+// torno do centro da faixa, curva opcional e ganho/deslocamento para a faixa
+// de saida, com saturacao. out_min > out_max inverte o sentido. A saida deve
+// caber em 16 bits (-32768..32767, ou 0..65535 se nao houver negativos).
+typedef struct {
+  axis_map_mode_t mode;
+  int32_t in_min, in_max;
+  int32_t out_min, out_max;
+  uint16_t dead_zone;
+  const uint16_t *curve;  // AXIS_CURVE_POINTS pontos nao decrescentes, ou NULL (linear)
+} axis_map_config_t;
+
+// Coeficientes pre-calculados por axis_map_init; a avaliacao nao divide
+typedef struct {
+  axis_map_mode_t mode;
+  int32_t center;
+  uint32_t dead_zone, span;   // Curso util fora da zona morta
+  uint32_t norm_scale;        // 32767 / span em Q16
+  const uint16_t *curve;
+  uint32_t gain, bias;        // Saida = (u * gain + bias) >> 16, em aritmetica modular
+  int32_t lo, hi;             // Limites da saturacao
+  bool is_signed;
+} axis_map_t;
+
+// Curva quadratica (mais precisao perto do centro)
+extern const uint16_t axis_curve_quadratic[AXIS_CURVE_POINTS];
+
+void axis_map_init(axis_map_t *map, const axis_map_config_t *config);
+
+// Configura os interpoladores do nucleo atual (no-op sem interpolador).
+// O estado dos interpoladores e por nucleo e nao e salvo: axis_map nao deve
+// ser chamado de IRQs enquanto o laco principal tambem o usa.
+void axis_map_hw_init(void);
+
+// Avaliacao com o backend do alvo (interpolador do RP2040 quando disponivel)
+int32_t axis_map(const axis_map_t *map, int32_t in);
+// Avaliacao em C portavel; resultado identico bit a bit ao de axis_map
+int32_t axis_map_portable(const axis_map_t *map, int32_t in);
+
+#endif
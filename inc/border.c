@@ -0,0 +1,26 @@
+#include "border.h"
+
+void draw_border(ssd1306_t *ssd, uint8_t style) {
+  // Desenha diferentes estilos de borda no display
+  switch (style) {
+    case 0: // Borda simples
+      ssd1306_rect(ssd, 0, 0, WIDTH, HEIGHT, true, false);
+      break;
+    case 1: // Borda dupla
+      ssd1306_rect(ssd, 0, 0, WIDTH, HEIGHT, true, false);
+      ssd1306_rect(ssd, 2, 2, WIDTH - 4, HEIGHT - 4, true, false);
+      break;
+    case 2: // Borda com cantos
+      // Linhas horizontais
+      ssd1306_hline(ssd, 0, 10, 0, true);
+      ssd1306_hline(ssd, WIDTH - 10, WIDTH - 1, 0, true);
+      ssd1306_hline(ssd, 0, 10, HEIGHT - 1, true);
+      ssd1306_hline(ssd, WIDTH - 10, WIDTH - 1, HEIGHT - 1, true);
+      // Linhas verticais
+      ssd1306_vline(ssd, 0, 0, 10, true);
+      ssd1306_vline(ssd, 0, HEIGHT - 10, HEIGHT - 1, true);
+      ssd1306_vline(ssd, WIDTH - 1, 0, 10, true);
+      ssd1306_vline(ssd, WIDTH - 1, HEIGHT - 10, HEIGHT - 1, true);
+      break;
+  }
+}
@@ -0,0 +1,12 @@
+#ifndef BORDER_H
+#define BORDER_H
+
+#include <stdint.h>
+#include "ssd1306.h"
+
+// Estilos da moldura da tela: simples, dupla e so os cantos
+#define BORDER_STYLES 3
+
+void draw_border(ssd1306_t *ssd, uint8_t style);
+
+#endif
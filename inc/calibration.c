@@ -0,0 +1,89 @@
+#include <string.h>
+#include "calibration.h"
+
+// Valores usados sem calibracao: faixa total do ADC e 40 contagens de zona morta
+#define DEFAULT_CENTER 32768
+#define DEFAULT_MIN 0
+#define DEFAULT_MAX 65520
+#define DEFAULT_DEAD_ZONE 640
+
+// Recalcula cursos e reciprocas a partir de centro, extremos e zona morta
+void axis_calibration_update(axis_calibration_t *axis) {
+  int32_t neg = (int32_t)axis->center - axis->min - axis->dead_zone;
+  int32_t pos = (int32_t)axis->max - axis->center - axis->dead_zone;
+  axis->neg_span = neg > 0 ? neg : 1;
+  axis->pos_span = pos > 0 ? pos : 1;
+  // t < span garante t * scale < 2^32 no mapeamento
+  axis->neg_scale = ((uint32_t)CALIBRATION_FULL << 16) / axis->neg_span;
+  axis->pos_scale = ((uint32_t)CALIBRATION_FULL << 16) / axis->pos_span;
+}
+
+static void axis_default(axis_calibration_t *axis) {
+  axis->center = DEFAULT_CENTER;
+  axis->min = DEFAULT_MIN;
+  axis->max = DEFAULT_MAX;
+  axis->dead_zone = DEFAULT_DEAD_ZONE;
+  axis_calibration_update(axis);
+}
+
+void calibration_default(joystick_calibration_t *cal) {
+  axis_default(&cal->x);
+  axis_default(&cal->y);
+}
+
+void calibration_start(calibration_session_t *session) {
+  memset(session, 0, sizeof(*session));
+  session->phase = CALIBRATION_REST;
+  session->rest_min_x = session->rest_min_y = 0xFFFF;
+  session->min_x = session->min_y = 0xFFFF;
+}
+
+void calibration_feed(calibration_session_t *session, uint16_t x, uint16_t y) {
+  switch (session->phase) {
+    case CALIBRATION_REST:
+      session->sum_x += x;
+      session->sum_y += y;
+      if (x < session->rest_min_x) session->rest_min_x = x;
+      if (x > session->rest_max_x) session->rest_max_x = x;
+      if (y < session->rest_min_y) session->rest_min_y = y;
+      if (y > session->rest_max_y) session->rest_max_y = y;
+      if (++session->count == CALIBRATION_REST_SAMPLES)
+        session->phase = CALIBRATION_SWEEP;
+      break;
+    case CALIBRATION_SWEEP:
+      if (x < session->min_x) session->min_x = x;
+      if (x > session->max_x) session->max_x = x;
+      if (y < session->min_y) session->min_y = y;
+      if (y > session->max_y) session->max_y = y;
+      break;
+    default:
+      break;
+  }
+}
+
+// Centro = media em repouso; zona morta = o dobro do desvio em repouso, com
+// o padrao como minimo. Lados com curso menor que CALIBRATION_MIN_SPAN
+// (nao varridos) mantem o extremo padrao.
+static void axis_learn(axis_calibration_t *axis, uint32_t sum, uint16_t rest_min, uint16_t rest_max,
+                       uint16_t min, uint16_t max, bool swept) {
+  axis->center = sum / CALIBRATION_REST_SAMPLES;
+  uint16_t noise = rest_max - rest_min;
+  axis->dead_zone = noise > DEFAULT_DEAD_ZONE / 2 ? noise * 2 : DEFAULT_DEAD_ZONE;
+  axis->min = (swept && axis->center - min >= CALIBRATION_MIN_SPAN) ? min : DEFAULT_MIN;
+  axis->max = (swept && max - axis->center >= CALIBRATION_MIN_SPAN) ? max : DEFAULT_MAX;
+  axis_calibration_update(axis);
+}
+
+// Encerra a sessao; false se o centro ainda nao foi aprendido
+bool calibration_finish(calibration_session_t *session, joystick_calibration_t *cal) {
+  bool ok = session->phase == CALIBRATION_SWEEP;
+  if (ok) {
+    bool swept = session->min_x <= session->max_x;
+    axis_learn(&cal->x, session->sum_x, session->rest_min_x, session->rest_max_x,
+               session->min_x, session->max_x, swept);
+    axis_learn(&cal->y, session->sum_y, session->rest_min_y, session->rest_max_y,
+               session->min_y, session->max_y, swept);
+  }
+  session->phase = CALIBRATION_IDLE;
+  return ok;
+}
@@ -0,0 +1,70 @@
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Saida normalizada de um eixo: -CALIBRATION_FULL..CALIBRATION_FULL
+#define CALIBRATION_FULL 32767
+
+// Amostras (saidas do filtro) usadas para aprender o centro em repouso
+#define CALIBRATION_REST_SAMPLES 256
+// Faixa minima aceita para um lado do eixo; abaixo disso usa o padrao
+#define CALIBRATION_MIN_SPAN 4096
+
+// Calibracao de um eixo na escala de 16 bits do filtro. As escalas sao
+// reciprocas em Q16 calculadas uma vez, para o mapeamento nao dividir.
+typedef struct {
+  uint16_t center;      // Posicao de repouso
+  uint16_t min, max;    // Extremos alcancados em cada direcao
+  uint16_t dead_zone;   // Meia largura da zona morta em torno do centro
+  uint16_t neg_span, pos_span;    // Curso util de cada lado, fora da zona morta
+  uint32_t neg_scale, pos_scale;  // CALIBRATION_FULL / span, em Q16
+} axis_calibration_t;
+
+typedef struct {
+  axis_calibration_t x, y;
+} joystick_calibration_t;
+
+typedef enum {
+  CALIBRATION_IDLE,
+  CALIBRATION_REST,     // Joystick solto: aprende centro e ruido
+  CALIBRATION_SWEEP,    // Usuario gira o joystick ate os extremos
+} calibration_phase_t;
+
+// Sessao de aprendizado alimentada com as saidas do filtro
+typedef struct {
+  calibration_phase_t phase;
+  uint32_t count;
+  uint32_t sum_x, sum_y;
+  uint16_t rest_min_x, rest_max_x, rest_min_y, rest_max_y;
+  uint16_t min_x, max_x, min_y, max_y;
+} calibration_session_t;
+
+void calibration_default(joystick_calibration_t *cal);
+void axis_calibration_update(axis_calibration_t *axis);
+
+void calibration_start(calibration_session_t *session);
+void calibration_feed(calibration_session_t *session, uint16_t x, uint16_t y);
+bool calibration_finish(calibration_session_t *session, joystick_calibration_t *cal);
+
+// Converte a leitura filtrada em -CALIBRATION_FULL..CALIBRATION_FULL,
+// com zero na zona morta; apenas comparacoes, uma multiplicacao e um shift
+static inline int32_t axis_calibration_apply(const axis_calibration_t *axis, uint16_t raw) {
+  int32_t d = (int32_t)raw - axis->center;
+  if (d > axis->dead_zone) {
+    uint32_t t = d - axis->dead_zone;
+    return t >= axis->pos_span ? CALIBRATION_FULL : (int32_t)((t * axis->pos_scale) >> 16);
+  }
+  if (d < -(int32_t)axis->dead_zone) {
+    uint32_t t = -d - axis->dead_zone;
+    return t >= axis->neg_span ? -CALIBRATION_FULL : -(int32_t)((t * axis->neg_scale) >> 16);
+  }
+  return 0;
+}
+
+// Persistencia em um setor reservado no fim da flash (calibration_flash.c)
+bool calibration_load(joystick_calibration_t *cal);
+bool calibration_save(const joystick_calibration_t *cal);
+
+#endif
@@ -0,0 +1,60 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "calibration.h"
+
+// Ultimo setor da flash, reservado para a calibracao
+#define CALIBRATION_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+#define CALIBRATION_MAGIC 0x4A43414Cu   // "LACJ"
+#define CALIBRATION_VERSION 1
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  joystick_calibration_t cal;
+  uint32_t checksum;
+} calibration_record_t;
+
+static uint32_t calibration_checksum(const calibration_record_t *record) {
+  // FNV-1a sobre tudo que precede o checksum
+  const uint8_t *p = (const uint8_t *)record;
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < offsetof(calibration_record_t, checksum); ++i)
+    hash = (hash ^ p[i]) * 16777619u;
+  return hash;
+}
+
+bool calibration_load(joystick_calibration_t *cal) {
+  const calibration_record_t *record = (const calibration_record_t *)(XIP_BASE + CALIBRATION_FLASH_OFFSET);
+  if (record->magic != CALIBRATION_MAGIC || record->version != CALIBRATION_VERSION ||
+      record->checksum != calibration_checksum(record))
+    return false;
+  *cal = record->cal;
+  // As reciprocas sao recalculadas para nao depender do que foi gravado
+  axis_calibration_update(&cal->x);
+  axis_calibration_update(&cal->y);
+  return true;
+}
+
+bool calibration_save(const joystick_calibration_t *cal) {
+  static uint8_t page[FLASH_PAGE_SIZE];
+  calibration_record_t record;
+  memset(&record, 0, sizeof(record));
+  record.magic = CALIBRATION_MAGIC;
+  record.version = CALIBRATION_VERSION;
+  record.cal = *cal;
+  record.checksum = calibration_checksum(&record);
+
+  memset(page, 0xFF, sizeof(page));
+  memcpy(page, &record, sizeof(record));
+
+  // A flash fica inacessivel durante a gravacao: nenhuma IRQ pode executar dela
+  uint32_t irq = save_and_disable_interrupts();
+  flash_range_erase(CALIBRATION_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+  flash_range_program(CALIBRATION_FLASH_OFFSET, page, FLASH_PAGE_SIZE);
+  restore_interrupts(irq);
+
+  joystick_calibration_t check;
+  return calibration_load(&check) && !memcmp(&check, cal, sizeof(check));
+}
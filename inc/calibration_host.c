@@ -0,0 +1,19 @@
+#include <string.h>
+#include "calibration.h"
+
+// Sem flash no host: a calibracao gravada dura so enquanto o processo roda
+static joystick_calibration_t stored;
+static bool stored_valid = false;
+
+bool calibration_load(joystick_calibration_t *cal) {
+  if (!stored_valid)
+    return false;
+  *cal = stored;
+  return true;
+}
+
+bool calibration_save(const joystick_calibration_t *cal) {
+  stored = *cal;
+  stored_valid = true;
+  return true;
+}
@@ -0,0 +1,34 @@
+#include <string.h>
+#include "debounce.h"
+
+void debounce_init(debounce_t *d, uint32_t mask, uint32_t initial, uint32_t sample_us, uint32_t settle_us) {
+  memset(d, 0, sizeof(*d));
+  d->mask = mask;
+  d->state = initial & mask;
+  d->sample_us = sample_us ? sample_us : 1;
+  uint32_t samples = (settle_us + d->sample_us - 1) / d->sample_us;
+  d->samples = samples < 1 ? 1 : samples > DEBOUNCE_MAX_SAMPLES ? DEBOUNCE_MAX_SAMPLES : samples;
+}
+
+uint32_t debounce_update(debounce_t *d, uint32_t raw, uint32_t now_us) {
+  // Pinos cuja leitura difere do estado estavel contam; os demais zeram
+  uint32_t delta = (raw ^ d->state) & d->mask;
+  uint32_t carry = delta;
+  uint32_t reached = delta;
+  for (int i = 0; i < DEBOUNCE_COUNTER_BITS; ++i) {
+    uint32_t c = d->count[i] & delta;
+    uint32_t next = c ^ carry;
+    carry &= c;
+    d->count[i] = next;
+    // Contador == samples, comparado bit a bit
+    reached &= (d->samples >> i) & 1 ? next : ~next;
+  }
+
+  if (reached) {
+    d->state ^= reached;
+    for (int i = 0; i < DEBOUNCE_COUNTER_BITS; ++i)
+      d->count[i] &= ~reached;
+    d->edge_us = now_us - (uint32_t)(d->samples - 1) * d->sample_us;
+  }
+  return reached;
+}
@@ -0,0 +1,40 @@
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Bits do contador vertical: ate 2^DEBOUNCE_COUNTER_BITS - 1 amostras
+#define DEBOUNCE_COUNTER_BITS 4
+#define DEBOUNCE_MAX_SAMPLES ((1u << DEBOUNCE_COUNTER_BITS) - 1)
+
+// Debounce de ate 32 pinos em paralelo sobre uma leitura de gpio_get_all().
+// Cada pino tem seu proprio contador, guardado "na vertical" (bit i do
+// contador de todos os pinos em count[i]), entao cada amostra custa o mesmo
+// numero de operacoes para 1 ou 32 pinos. Um pino muda de estado depois de
+// `samples` leituras seguidas diferentes do estado estavel.
+typedef struct {
+  uint32_t mask;                          // Pinos monitorados
+  uint32_t state;                         // Nivel estavel de cada pino
+  uint32_t count[DEBOUNCE_COUNTER_BITS];  // Contadores verticais
+  uint8_t samples;                        // Leituras para aceitar uma mudanca
+  uint32_t sample_us;                     // Intervalo entre leituras
+  uint32_t edge_us;                       // Instante das mudancas da ultima atualizacao
+} debounce_t;
+
+// settle_us e arredondado para o numero de amostras, limitado a 1..DEBOUNCE_MAX_SAMPLES
+void debounce_init(debounce_t *d, uint32_t mask, uint32_t initial, uint32_t sample_us, uint32_t settle_us);
+
+// Processa uma leitura; retorna os pinos que mudaram de estado. O instante
+// da mudanca (primeira leitura do novo nivel) fica em edge_us.
+uint32_t debounce_update(debounce_t *d, uint32_t raw, uint32_t now_us);
+
+// Instante ate o qual todas as mudancas ja foram reportadas: uma mudanca com
+// edge_us = t so aparece na leitura de t + (samples - 1) * sample_us. Prazos
+// medidos contra edge_us (gestos) devem avancar por este relogio, nao pelo
+// atual, para nao vencerem antes de uma borda ainda em acomodacao.
+static inline uint32_t debounce_settled_us(const debounce_t *d, uint32_t now_us) {
+  return now_us - (uint32_t)(d->samples - 1) * d->sample_us;
+}
+
+#endif
@@ -0,0 +1,7 @@
+#include "event_queue.h"
+
+void event_queue_init(event_queue_t *q) {
+  atomic_init(&q->head, 0);
+  atomic_init(&q->tail, 0);
+  atomic_init(&q->dropped, 0);
+}
@@ -0,0 +1,56 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Capacidade da fila (potencia de 2)
+#define EVENT_QUEUE_SIZE 32
+
+// Evento de entrada registrado pela IRQ
+typedef struct {
+  uint32_t time_us;   // time_us_32() no momento da interrupcao
+  uint8_t pin;
+  uint8_t edge;       // Mascara GPIO_IRQ_EDGE_* recebida
+} input_event_t;
+
+// Fila SPSC: a IRQ e a unica produtora e o laco principal o unico
+// consumidor. head so e escrito pelo produtor e tail so pelo consumidor,
+// entao basta ordenar os acessos, sem desabilitar interrupcoes.
+typedef struct {
+  input_event_t events[EVENT_QUEUE_SIZE];
+  _Atomic uint32_t head;    // Eventos escritos
+  _Atomic uint32_t tail;    // Eventos consumidos
+  _Atomic uint32_t dropped; // Eventos perdidos com a fila cheia
+} event_queue_t;
+
+void event_queue_init(event_queue_t *q);
+
+// Produtor: false (e o evento contado em dropped) se a fila estiver cheia
+static inline bool event_queue_push(event_queue_t *q, uint8_t pin, uint8_t edge, uint32_t time_us) {
+  uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  if (head - atomic_load_explicit(&q->tail, memory_order_acquire) == EVENT_QUEUE_SIZE) {
+    atomic_store_explicit(&q->dropped, atomic_load_explicit(&q->dropped, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+    return false;
+  }
+  input_event_t *e = &q->events[head % EVENT_QUEUE_SIZE];
+  e->time_us = time_us;
+  e->pin = pin;
+  e->edge = edge;
+  atomic_store_explicit(&q->head, head + 1, memory_order_release);
+  return true;
+}
+
+// Consumidor: false se a fila estiver vazia
+static inline bool event_queue_pop(event_queue_t *q, input_event_t *out) {
+  uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  if (tail == atomic_load_explicit(&q->head, memory_order_acquire))
+    return false;
+  *out = q->events[tail % EVENT_QUEUE_SIZE];
+  atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+  return true;
+}
+
+#endif
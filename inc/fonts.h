@@ -0,0 +1,40 @@
+#ifndef FONTS_H
+#define FONTS_H
+
+#include <stdint.h>
+
+// Glifo de uma fonte: bitmap em colunas de ceil(height / 8) bytes, bit 0 no
+// topo, no mesmo formato das paginas do SSD1306
+typedef struct {
+  uint16_t offset;    // Inicio do bitmap em font_t.bitmap
+  uint8_t width;      // Colunas do bitmap
+  uint8_t height;     // Linhas do bitmap
+  uint8_t advance;    // Avanco horizontal ate o proximo caractere
+  int8_t x_offset;    // Deslocamento do bitmap a partir da origem
+  int8_t y_offset;    // Deslocamento do bitmap a partir do topo da linha
+} font_glyph_t;
+
+// Fonte com glifos para os caracteres first..last; os demais usam fallback
+typedef struct {
+  const uint8_t *bitmap;
+  const font_glyph_t *glyphs;
+  uint8_t first, last;
+  uint8_t fallback;
+  uint8_t line_height;
+} font_t;
+
+// Fonte 8x8 original (A-Z, 0-9, "camil" e "!" de 16x16), usada por ssd1306_draw_char
+extern const font_t font_8x8;
+
+// Fontes geradas por tools/bdf2font.py a partir de fonts/*.bdf
+extern const font_t font_5x7;      // Proporcional, ASCII 32-126, linha de 8 pixels
+extern const font_t font_5x7_x2;   // font_5x7 em escala 2, linha de 16 pixels
+
+static inline const font_glyph_t *font_glyph(const font_t *font, char c) {
+  uint8_t code = (uint8_t)c;
+  if (code < font->first || code > font->last)
+    code = font->fallback;
+  return &font->glyphs[code - font->first];
+}
+
+#endif
@@ -0,0 +1,206 @@
+// Gerado por tools/bdf2font.py a partir de fonts/5x7.bdf - nao editar
+#include "../fonts.h"
+
+static const uint8_t font_5x7_bitmap[] = {
+  0x5f, // !
+  0x07, 0x00, 0x07, // "
+  0x14, 0x7f, 0x14, 0x7f, 0x14, // #
+  0x24, 0x2a, 0x7f, 0x2a, 0x12, // $
+  0x23, 0x13, 0x08, 0x64, 0x62, // %
+  0x36, 0x49, 0x55, 0x22, 0x50, // &
+  0x05, 0x03, // '
+  0x1c, 0x22, 0x41, // (
+  0x41, 0x22, 0x1c, // )
+  0x0a, 0x04, 0x1f, 0x04, 0x0a, // *
+  0x04, 0x04, 0x1f, 0x04, 0x04, // +
+  0x05, 0x03, // ,
+  0x01, 0x01, 0x01, 0x01, 0x01, // -
+  0x03, 0x03, // .
+  0x10, 0x08, 0x04, 0x02, 0x01, // /
+  0x3e, 0x51, 0x49, 0x45, 0x3e, // 0
+  0x42, 0x7f, 0x40, // 1
+  0x42, 0x61, 0x51, 0x49, 0x46, // 2
+  0x21, 0x41, 0x45, 0x4b, 0x31, // 3
+  0x18, 0x14, 0x12, 0x7f, 0x10, // 4
+  0x27, 0x45, 0x45, 0x45, 0x39, // 5
+  0x3c, 0x4a, 0x49, 0x49, 0x30, // 6
+  0x01, 0x71, 0x09, 0x05, 0x03, // 7
+  0x36, 0x49, 0x49, 0x49, 0x36, // 8
+  0x06, 0x49, 0x49, 0x29, 0x1e, // 9
+  0x1b, 0x1b, // :
+  0x2b, 0x1b, // ;
+  0x08, 0x14, 0x22, 0x41, // <
+  0x05, 0x05, 0x05, 0x05, 0x05, // =
+  0x41, 0x22, 0x14, 0x08, // >
+  0x02, 0x01, 0x51, 0x09, 0x06, // ?
+  0x32, 0x49, 0x79, 0x41, 0x3e, // @
+  0x7e, 0x11, 0x11, 0x11, 0x7e, // A
+  0x7f, 0x49, 0x49, 0x49, 0x36, // B
+  0x3e, 0x41, 0x41, 0x41, 0x22, // C
+  0x7f, 0x41, 0x41, 0x22, 0x1c, // D
+  0x7f, 0x49, 0x49, 0x49, 0x41, // E
+  0x7f, 0x09, 0x09, 0x09, 0x01, // F
+  0x3e, 0x41, 0x49, 0x49, 0x7a, // G
+  0x7f, 0x08, 0x08, 0x08, 0x7f, // H
+  0x41, 0x7f, 0x41, // I
+  0x20, 0x40, 0x41, 0x3f, 0x01, // J
+  0x7f, 0x08, 0x14, 0x22, 0x41, // K
+  0x7f, 0x40, 0x40, 0x40, 0x40, // L
+  0x7f, 0x02, 0x0c, 0x02, 0x7f, // M
+  0x7f, 0x04, 0x08, 0x10, 0x7f, // N
+  0x3e, 0x41, 0x41, 0x41, 0x3e, // O
+  0x7f, 0x09, 0x09, 0x09, 0x06, // P
+  0x3e, 0x41, 0x51, 0x21, 0x5e, // Q
+  0x7f, 0x09, 0x19, 0x29, 0x46, // R
+  0x46, 0x49, 0x49, 0x49, 0x31, // S
+  0x01, 0x01, 0x7f, 0x01, 0x01, // T
+  0x3f, 0x40, 0x40, 0x40, 0x3f, // U
+  0x1f, 0x20, 0x40, 0x20, 0x1f, // V
+  0x3f, 0x40, 0x38, 0x40, 0x3f, // W
+  0x63, 0x14, 0x08, 0x14, 0x63, // X
+  0x07, 0x08, 0x70, 0x08, 0x07, // Y
+  0x61, 0x51, 0x49, 0x45, 0x43, // Z
+  0x7f, 0x41, 0x41, // [
+  0x01, 0x02, 0x04, 0x08, 0x10, // barra invertida
+  0x41, 0x41, 0x7f, // ]
+  0x04, 0x02, 0x01, 0x02, 0x04, // ^
+  0x01, 0x01, 0x01, 0x01, 0x01, // _
+  0x01, 0x02, 0x04, // `
+  0x08, 0x15, 0x15, 0x15, 0x1e, // a
+  0x7f, 0x48, 0x44, 0x44, 0x38, // b
+  0x0e, 0x11, 0x11, 0x11, 0x08, // c
+  0x38, 0x44, 0x44, 0x48, 0x7f, // d
+  0x0e, 0x15, 0x15, 0x15, 0x06, // e
+  0x08, 0x7e, 0x09, 0x01, 0x02, // f
+  0x06, 0x29, 0x29, 0x29, 0x1f, // g
+  0x7f, 0x08, 0x04, 0x04, 0x78, // h
+  0x44, 0x7d, 0x40, // i
+  0x20, 0x40, 0x44, 0x3d, // j
+  0x7f, 0x10, 0x28, 0x44, // k
+  0x41, 0x7f, 0x40, // l
+  0x1f, 0x01, 0x06, 0x01, 0x1e, // m
+  0x1f, 0x02, 0x01, 0x01, 0x1e, // n
+  0x0e, 0x11, 0x11, 0x11, 0x0e, // o
+  0x1f, 0x05, 0x05, 0x05, 0x02, // p
+  0x02, 0x05, 0x05, 0x06, 0x1f, // q
+  0x1f, 0x02, 0x01, 0x01, 0x02, // r
+  0x12, 0x15, 0x15, 0x15, 0x08, // s
+  0x04, 0x3f, 0x44, 0x40, 0x20, // t
+  0x0f, 0x10, 0x10, 0x08, 0x1f, // u
+  0x07, 0x08, 0x10, 0x08, 0x07, // v
+  0x0f, 0x10, 0x0c, 0x10, 0x0f, // w
+  0x11, 0x0a, 0x04, 0x0a, 0x11, // x
+  0x03, 0x14, 0x14, 0x14, 0x0f, // y
+  0x11, 0x19, 0x15, 0x13, 0x11, // z
+  0x08, 0x36, 0x41, // {
+  0x7f, // |
+  0x41, 0x36, 0x08, // }
+  0x02, 0x01, 0x02, 0x04, 0x02, // ~
+};
+
+static const font_glyph_t font_5x7_glyphs[] = {
+  { 0, 0, 0, 3, 0, 7 }, // espaco
+  { 0, 1, 7, 2, 0, 0 }, // !
+  { 1, 3, 3, 4, 0, 0 }, // "
+  { 4, 5, 7, 6, 0, 0 }, // #
+  { 9, 5, 7, 6, 0, 0 }, // $
+  { 14, 5, 7, 6, 0, 0 }, // %
+  { 19, 5, 7, 6, 0, 0 }, // &
+  { 24, 2, 3, 3, 0, 0 }, // '
+  { 26, 3, 7, 4, 0, 0 }, // (
+  { 29, 3, 7, 4, 0, 0 }, // )
+  { 32, 5, 5, 6, 0, 1 }, // *
+  { 37, 5, 5, 6, 0, 1 }, // +
+  { 42, 2, 3, 3, 0, 4 }, // ,
+  { 44, 5, 1, 6, 0, 3 }, // -
+  { 49, 2, 2, 3, 0, 5 }, // .
+  { 51, 5, 5, 6, 0, 1 }, // /
+  { 56, 5, 7, 6, 0, 0 }, // 0
+  { 61, 3, 7, 4, 0, 0 }, // 1
+  { 64, 5, 7, 6, 0, 0 }, // 2
+  { 69, 5, 7, 6, 0, 0 }, // 3
+  { 74, 5, 7, 6, 0, 0 }, // 4
+  { 79, 5, 7, 6, 0, 0 }, // 5
+  { 84, 5, 7, 6, 0, 0 }, // 6
+  { 89, 5, 7, 6, 0, 0 }, // 7
+  { 94, 5, 7, 6, 0, 0 }, // 8
+  { 99, 5, 7, 6, 0, 0 }, // 9
+  { 104, 2, 5, 3, 0, 1 }, // :
+  { 106, 2, 6, 3, 0, 1 }, // ;
+  { 108, 4, 7, 5, 0, 0 }, // <
+  { 112, 5, 3, 6, 0, 2 }, // =
+  { 117, 4, 7, 5, 0, 0 }, // >
+  { 121, 5, 7, 6, 0, 0 }, // ?
+  { 126, 5, 7, 6, 0, 0 }, // @
+  { 131, 5, 7, 6, 0, 0 }, // A
+  { 136, 5, 7, 6, 0, 0 }, // B
+  { 141, 5, 7, 6, 0, 0 }, // C
+  { 146, 5, 7, 6, 0, 0 }, // D
+  { 151, 5, 7, 6, 0, 0 }, // E
+  { 156, 5, 7, 6, 0, 0 }, // F
+  { 161, 5, 7, 6, 0, 0 }, // G
+  { 166, 5, 7, 6, 0, 0 }, // H
+  { 171, 3, 7, 4, 0, 0 }, // I
+  { 174, 5, 7, 6, 0, 0 }, // J
+  { 179, 5, 7, 6, 0, 0 }, // K
+  { 184, 5, 7, 6, 0, 0 }, // L
+  { 189, 5, 7, 6, 0, 0 }, // M
+  { 194, 5, 7, 6, 0, 0 }, // N
+  { 199, 5, 7, 6, 0, 0 }, // O
+  { 204, 5, 7, 6, 0, 0 }, // P
+  { 209, 5, 7, 6, 0, 0 }, // Q
+  { 214, 5, 7, 6, 0, 0 }, // R
+  { 219, 5, 7, 6, 0, 0 }, // S
+  { 224, 5, 7, 6, 0, 0 }, // T
+  { 229, 5, 7, 6, 0, 0 }, // U
+  { 234, 5, 7, 6, 0, 0 }, // V
+  { 239, 5, 7, 6, 0, 0 }, // W
+  { 244, 5, 7, 6, 0, 0 }, // X
+  { 249, 5, 7, 6, 0, 0 }, // Y
+  { 254, 5, 7, 6, 0, 0 }, // Z
+  { 259, 3, 7, 4, 0, 0 }, // [
+  { 262, 5, 5, 6, 0, 1 }, // barra invertida
+  { 267, 3, 7, 4, 0, 0 }, // ]
+  { 270, 5, 3, 6, 0, 0 }, // ^
+  { 275, 5, 1, 6, 0, 6 }, // _
+  { 280, 3, 3, 4, 0, 0 }, // `
+  { 283, 5, 5, 6, 0, 2 }, // a
+  { 288, 5, 7, 6, 0, 0 }, // b
+  { 293, 5, 5, 6, 0, 2 }, // c
+  { 298, 5, 7, 6, 0, 0 }, // d
+  { 303, 5, 5, 6, 0, 2 }, // e
+  { 308, 5, 7, 6, 0, 0 }, // f
+  { 313, 5, 6, 6, 0, 1 }, // g
+  { 318, 5, 7, 6, 0, 0 }, // h
+  { 323, 3, 7, 4, 0, 0 }, // i
+  { 326, 4, 7, 5, 0, 0 }, // j
+  { 330, 4, 7, 5, 0, 0 }, // k
+  { 334, 3, 7, 4, 0, 0 }, // l
+  { 337, 5, 5, 6, 0, 2 }, // m
+  { 342, 5, 5, 6, 0, 2 }, // n
+  { 347, 5, 5, 6, 0, 2 }, // o
+  { 352, 5, 5, 6, 0, 2 }, // p
+  { 357, 5, 5, 6, 0, 2 }, // q
+  { 362, 5, 5, 6, 0, 2 }, // r
+  { 367, 5, 5, 6, 0, 2 }, // s
+  { 372, 5, 7, 6, 0, 0 }, // t
+  { 377, 5, 5, 6, 0, 2 }, // u
+  { 382, 5, 5, 6, 0, 2 }, // v
+  { 387, 5, 5, 6, 0, 2 }, // w
+  { 392, 5, 5, 6, 0, 2 }, // x
+  { 397, 5, 5, 6, 0, 2 }, // y
+  { 402, 5, 5, 6, 0, 2 }, // z
+  { 407, 3, 7, 4, 0, 0 }, // {
+  { 410, 1, 7, 2, 0, 0 }, // |
+  { 411, 3, 7, 4, 0, 0 }, // }
+  { 414, 5, 3, 6, 0, 2 }, // ~
+};
+
+const font_t font_5x7 = {
+  .bitmap = font_5x7_bitmap,
+  .glyphs = font_5x7_glyphs,
+  .first = 32,
+  .last = 126,
+  .fallback = 63,
+  .line_height = 8,
+};
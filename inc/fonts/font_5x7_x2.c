@@ -0,0 +1,206 @@
+// Gerado por tools/bdf2font.py a partir de fonts/5x7.bdf (escala 2) - nao editar
+#include "../fonts.h"
+
+static const uint8_t font_5x7_x2_bitmap[] = {
+  0xff, 0x33, 0xff, 0x33, // !
+  0x3f, 0x3f, 0x00, 0x00, 0x3f, 0x3f, // "
+  0x30, 0x03, 0x30, 0x03, 0xff, 0x3f, 0xff, 0x3f, 0x30, 0x03, 0x30, 0x03, 0xff, 0x3f, 0xff, 0x3f, 0x30, 0x03, 0x30, 0x03, // #
+  0x30, 0x0c, 0x30, 0x0c, 0xcc, 0x0c, 0xcc, 0x0c, 0xff, 0x3f, 0xff, 0x3f, 0xcc, 0x0c, 0xcc, 0x0c, 0x0c, 0x03, 0x0c, 0x03, // $
+  0x0f, 0x0c, 0x0f, 0x0c, 0x0f, 0x03, 0x0f, 0x03, 0xc0, 0x00, 0xc0, 0x00, 0x30, 0x3c, 0x30, 0x3c, 0x0c, 0x3c, 0x0c, 0x3c, // %
+  0x3c, 0x0f, 0x3c, 0x0f, 0xc3, 0x30, 0xc3, 0x30, 0x33, 0x33, 0x33, 0x33, 0x0c, 0x0c, 0x0c, 0x0c, 0x00, 0x33, 0x00, 0x33, // &
+  0x33, 0x33, 0x0f, 0x0f, // '
+  0xf0, 0x03, 0xf0, 0x03, 0x0c, 0x0c, 0x0c, 0x0c, 0x03, 0x30, 0x03, 0x30, // (
+  0x03, 0x30, 0x03, 0x30, 0x0c, 0x0c, 0x0c, 0x0c, 0xf0, 0x03, 0xf0, 0x03, // )
+  0xcc, 0x00, 0xcc, 0x00, 0x30, 0x00, 0x30, 0x00, 0xff, 0x03, 0xff, 0x03, 0x30, 0x00, 0x30, 0x00, 0xcc, 0x00, 0xcc, 0x00, // *
+  0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0xff, 0x03, 0xff, 0x03, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, // +
+  0x33, 0x33, 0x0f, 0x0f, // ,
+  0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, // -
+  0x0f, 0x0f, 0x0f, 0x0f, // .
+  0x00, 0x03, 0x00, 0x03, 0xc0, 0x00, 0xc0, 0x00, 0x30, 0x00, 0x30, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x03, 0x00, 0x03, 0x00, // /
+  0xfc, 0x0f, 0xfc, 0x0f, 0x03, 0x33, 0x03, 0x33, 0xc3, 0x30, 0xc3, 0x30, 0x33, 0x30, 0x33, 0x30, 0xfc, 0x0f, 0xfc, 0x0f, // 0
+  0x0c, 0x30, 0x0c, 0x30, 0xff, 0x3f, 0xff, 0x3f, 0x00, 0x30, 0x00, 0x30, // 1
+  0x0c, 0x30, 0x0c, 0x30, 0x03, 0x3c, 0x03, 0x3c, 0x03, 0x33, 0x03, 0x33, 0xc3, 0x30, 0xc3, 0x30, 0x3c, 0x30, 0x3c, 0x30, // 2
+  0x03, 0x0c, 0x03, 0x0c, 0x03, 0x30, 0x03, 0x30, 0x33, 0x30, 0x33, 0x30, 0xcf, 0x30, 0xcf, 0x30, 0x03, 0x0f, 0x03, 0x0f, // 3
+  0xc0, 0x03, 0xc0, 0x03, 0x30, 0x03, 0x30, 0x03, 0x0c, 0x03, 0x0c, 0x03, 0xff, 0x3f, 0xff, 0x3f, 0x00, 0x03, 0x00, 0x03, // 4
+  0x3f, 0x0c, 0x3f, 0x0c, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, 0x30, 0xc3, 0x0f, 0xc3, 0x0f, // 5
+  0xf0, 0x0f, 0xf0, 0x0f, 0xcc, 0x30, 0xcc, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0x00, 0x0f, 0x00, 0x0f, // 6
+  0x03, 0x00, 0x03, 0x00, 0x03, 0x3f, 0x03, 0x3f, 0xc3, 0x00, 0xc3, 0x00, 0x33, 0x00, 0x33, 0x00, 0x0f, 0x00, 0x0f, 0x00, // 7
+  0x3c, 0x0f, 0x3c, 0x0f, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0x3c, 0x0f, 0x3c, 0x0f, // 8
+  0x3c, 0x00, 0x3c, 0x00, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x0c, 0xc3, 0x0c, 0xfc, 0x03, 0xfc, 0x03, // 9
+  0xcf, 0x03, 0xcf, 0x03, 0xcf, 0x03, 0xcf, 0x03, // :
+  0xcf, 0x0c, 0xcf, 0x0c, 0xcf, 0x03, 0xcf, 0x03, // ;
+  0xc0, 0x00, 0xc0, 0x00, 0x30, 0x03, 0x30, 0x03, 0x0c, 0x0c, 0x0c, 0x0c, 0x03, 0x30, 0x03, 0x30, // <
+  0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, // =
+  0x03, 0x30, 0x03, 0x30, 0x0c, 0x0c, 0x0c, 0x0c, 0x30, 0x03, 0x30, 0x03, 0xc0, 0x00, 0xc0, 0x00, // >
+  0x0c, 0x00, 0x0c, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x33, 0x03, 0x33, 0xc3, 0x00, 0xc3, 0x00, 0x3c, 0x00, 0x3c, 0x00, // ?
+  0x0c, 0x0f, 0x0c, 0x0f, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x3f, 0xc3, 0x3f, 0x03, 0x30, 0x03, 0x30, 0xfc, 0x0f, 0xfc, 0x0f, // @
+  0xfc, 0x3f, 0xfc, 0x3f, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xfc, 0x3f, 0xfc, 0x3f, // A
+  0xff, 0x3f, 0xff, 0x3f, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0x3c, 0x0f, 0x3c, 0x0f, // B
+  0xfc, 0x0f, 0xfc, 0x0f, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x0c, 0x0c, 0x0c, 0x0c, // C
+  0xff, 0x3f, 0xff, 0x3f, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x0c, 0x0c, 0x0c, 0x0c, 0xf0, 0x03, 0xf0, 0x03, // D
+  0xff, 0x3f, 0xff, 0x3f, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0x03, 0x30, 0x03, 0x30, // E
+  0xff, 0x3f, 0xff, 0x3f, 0xc3, 0x00, 0xc3, 0x00, 0xc3, 0x00, 0xc3, 0x00, 0xc3, 0x00, 0xc3, 0x00, 0x03, 0x00, 0x03, 0x00, // F
+  0xfc, 0x0f, 0xfc, 0x0f, 0x03, 0x30, 0x03, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xcc, 0x3f, 0xcc, 0x3f, // G
+  0xff, 0x3f, 0xff, 0x3f, 0xc0, 0x00, 0xc0, 0x00, 0xc0, 0x00, 0xc0, 0x00, 0xc0, 0x00, 0xc0, 0x00, 0xff, 0x3f, 0xff, 0x3f, // H
+  0x03, 0x30, 0x03, 0x30, 0xff, 0x3f, 0xff, 0x3f, 0x03, 0x30, 0x03, 0x30, // I
+  0x00, 0x0c, 0x00, 0x0c, 0x00, 0x30, 0x00, 0x30, 0x03, 0x30, 0x03, 0x30, 0xff, 0x0f, 0xff, 0x0f, 0x03, 0x00, 0x03, 0x00, // J
+  0xff, 0x3f, 0xff, 0x3f, 0xc0, 0x00, 0xc0, 0x00, 0x30, 0x03, 0x30, 0x03, 0x0c, 0x0c, 0x0c, 0x0c, 0x03, 0x30, 0x03, 0x30, // K
+  0xff, 0x3f, 0xff, 0x3f, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, // L
+  0xff, 0x3f, 0xff, 0x3f, 0x0c, 0x00, 0x0c, 0x00, 0xf0, 0x00, 0xf0, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0xff, 0x3f, 0xff, 0x3f, // M
+  0xff, 0x3f, 0xff, 0x3f, 0x30, 0x00, 0x30, 0x00, 0xc0, 0x00, 0xc0, 0x00, 0x00, 0x03, 0x00, 0x03, 0xff, 0x3f, 0xff, 0x3f, // N
+  0xfc, 0x0f, 0xfc, 0x0f, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0xfc, 0x0f, 0xfc, 0x0f, // O
+  0xff, 0x3f, 0xff, 0x3f, 0xc3, 0x00, 0xc3, 0x00, 0xc3, 0x00, 0xc3, 0x00, 0xc3, 0x00, 0xc3, 0x00, 0x3c, 0x00, 0x3c, 0x00, // P
+  0xfc, 0x0f, 0xfc, 0x0f, 0x03, 0x30, 0x03, 0x30, 0x03, 0x33, 0x03, 0x33, 0x03, 0x0c, 0x03, 0x0c, 0xfc, 0x33, 0xfc, 0x33, // Q
+  0xff, 0x3f, 0xff, 0x3f, 0xc3, 0x00, 0xc3, 0x00, 0xc3, 0x03, 0xc3, 0x03, 0xc3, 0x0c, 0xc3, 0x0c, 0x3c, 0x30, 0x3c, 0x30, // R
+  0x3c, 0x30, 0x3c, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0xc3, 0x30, 0x03, 0x0f, 0x03, 0x0f, // S
+  0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0xff, 0x3f, 0xff, 0x3f, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, // T
+  0xff, 0x0f, 0xff, 0x0f, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0xff, 0x0f, 0xff, 0x0f, // U
+  0xff, 0x03, 0xff, 0x03, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x30, 0x00, 0x30, 0x00, 0x0c, 0x00, 0x0c, 0xff, 0x03, 0xff, 0x03, // V
+  0xff, 0x0f, 0xff, 0x0f, 0x00, 0x30, 0x00, 0x30, 0xc0, 0x0f, 0xc0, 0x0f, 0x00, 0x30, 0x00, 0x30, 0xff, 0x0f, 0xff, 0x0f, // W
+  0x0f, 0x3c, 0x0f, 0x3c, 0x30, 0x03, 0x30, 0x03, 0xc0, 0x00, 0xc0, 0x00, 0x30, 0x03, 0x30, 0x03, 0x0f, 0x3c, 0x0f, 0x3c, // X
+  0x3f, 0x00, 0x3f, 0x00, 0xc0, 0x00, 0xc0, 0x00, 0x00, 0x3f, 0x00, 0x3f, 0xc0, 0x00, 0xc0, 0x00, 0x3f, 0x00, 0x3f, 0x00, // Y
+  0x03, 0x3c, 0x03, 0x3c, 0x03, 0x33, 0x03, 0x33, 0xc3, 0x30, 0xc3, 0x30, 0x33, 0x30, 0x33, 0x30, 0x0f, 0x30, 0x0f, 0x30, // Z
+  0xff, 0x3f, 0xff, 0x3f, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, // [
+  0x03, 0x00, 0x03, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x30, 0x00, 0x30, 0x00, 0xc0, 0x00, 0xc0, 0x00, 0x00, 0x03, 0x00, 0x03, // barra invertida
+  0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0xff, 0x3f, 0xff, 0x3f, // ]
+  0x30, 0x30, 0x0c, 0x0c, 0x03, 0x03, 0x0c, 0x0c, 0x30, 0x30, // ^
+  0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, // _
+  0x03, 0x03, 0x0c, 0x0c, 0x30, 0x30, // `
+  0xc0, 0x00, 0xc0, 0x00, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0xfc, 0x03, 0xfc, 0x03, // a
+  0xff, 0x3f, 0xff, 0x3f, 0xc0, 0x30, 0xc0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xc0, 0x0f, 0xc0, 0x0f, // b
+  0xfc, 0x00, 0xfc, 0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xc0, 0x00, 0xc0, 0x00, // c
+  0xc0, 0x0f, 0xc0, 0x0f, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xc0, 0x30, 0xc0, 0x30, 0xff, 0x3f, 0xff, 0x3f, // d
+  0xfc, 0x00, 0xfc, 0x00, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x3c, 0x00, 0x3c, 0x00, // e
+  0xc0, 0x00, 0xc0, 0x00, 0xfc, 0x3f, 0xfc, 0x3f, 0xc3, 0x00, 0xc3, 0x00, 0x03, 0x00, 0x03, 0x00, 0x0c, 0x00, 0x0c, 0x00, // f
+  0x3c, 0x00, 0x3c, 0x00, 0xc3, 0x0c, 0xc3, 0x0c, 0xc3, 0x0c, 0xc3, 0x0c, 0xc3, 0x0c, 0xc3, 0x0c, 0xff, 0x03, 0xff, 0x03, // g
+  0xff, 0x3f, 0xff, 0x3f, 0xc0, 0x00, 0xc0, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0xc0, 0x3f, 0xc0, 0x3f, // h
+  0x30, 0x30, 0x30, 0x30, 0xf3, 0x3f, 0xf3, 0x3f, 0x00, 0x30, 0x00, 0x30, // i
+  0x00, 0x0c, 0x00, 0x0c, 0x00, 0x30, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30, 0xf3, 0x0f, 0xf3, 0x0f, // j
+  0xff, 0x3f, 0xff, 0x3f, 0x00, 0x03, 0x00, 0x03, 0xc0, 0x0c, 0xc0, 0x0c, 0x30, 0x30, 0x30, 0x30, // k
+  0x03, 0x30, 0x03, 0x30, 0xff, 0x3f, 0xff, 0x3f, 0x00, 0x30, 0x00, 0x30, // l
+  0xff, 0x03, 0xff, 0x03, 0x03, 0x00, 0x03, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0x03, 0x00, 0x03, 0x00, 0xfc, 0x03, 0xfc, 0x03, // m
+  0xff, 0x03, 0xff, 0x03, 0x0c, 0x00, 0x0c, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0xfc, 0x03, 0xfc, 0x03, // n
+  0xfc, 0x00, 0xfc, 0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xfc, 0x00, 0xfc, 0x00, // o
+  0xff, 0x03, 0xff, 0x03, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00, 0x0c, 0x00, 0x0c, 0x00, // p
+  0x0c, 0x00, 0x0c, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33, 0x00, 0x3c, 0x00, 0x3c, 0x00, 0xff, 0x03, 0xff, 0x03, // q
+  0xff, 0x03, 0xff, 0x03, 0x0c, 0x00, 0x0c, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x0c, 0x00, 0x0c, 0x00, // r
+  0x0c, 0x03, 0x0c, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0x33, 0x03, 0xc0, 0x00, 0xc0, 0x00, // s
+  0x30, 0x00, 0x30, 0x00, 0xff, 0x0f, 0xff, 0x0f, 0x30, 0x30, 0x30, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x0c, 0x00, 0x0c, // t
+  0xff, 0x00, 0xff, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0xc0, 0x00, 0xc0, 0x00, 0xff, 0x03, 0xff, 0x03, // u
+  0x3f, 0x00, 0x3f, 0x00, 0xc0, 0x00, 0xc0, 0x00, 0x00, 0x03, 0x00, 0x03, 0xc0, 0x00, 0xc0, 0x00, 0x3f, 0x00, 0x3f, 0x00, // v
+  0xff, 0x00, 0xff, 0x00, 0x00, 0x03, 0x00, 0x03, 0xf0, 0x00, 0xf0, 0x00, 0x00, 0x03, 0x00, 0x03, 0xff, 0x00, 0xff, 0x00, // w
+  0x03, 0x03, 0x03, 0x03, 0xcc, 0x00, 0xcc, 0x00, 0x30, 0x00, 0x30, 0x00, 0xcc, 0x00, 0xcc, 0x00, 0x03, 0x03, 0x03, 0x03, // x
+  0x0f, 0x00, 0x0f, 0x00, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0xff, 0x00, 0xff, 0x00, // y
+  0x03, 0x03, 0x03, 0x03, 0xc3, 0x03, 0xc3, 0x03, 0x33, 0x03, 0x33, 0x03, 0x0f, 0x03, 0x0f, 0x03, 0x03, 0x03, 0x03, 0x03, // z
+  0xc0, 0x00, 0xc0, 0x00, 0x3c, 0x0f, 0x3c, 0x0f, 0x03, 0x30, 0x03, 0x30, // {
+  0xff, 0x3f, 0xff, 0x3f, // |
+  0x03, 0x30, 0x03, 0x30, 0x3c, 0x0f, 0x3c, 0x0f, 0xc0, 0x00, 0xc0, 0x00, // }
+  0x0c, 0x0c, 0x03, 0x03, 0x0c, 0x0c, 0x30, 0x30, 0x0c, 0x0c, // ~
+};
+
+static const font_glyph_t font_5x7_x2_glyphs[] = {
+  { 0, 0, 0, 6, 0, 14 }, // espaco
+  { 0, 2, 14, 4, 0, 0 }, // !
+  { 4, 6, 6, 8, 0, 0 }, // "
+  { 10, 10, 14, 12, 0, 0 }, // #
+  { 30, 10, 14, 12, 0, 0 }, // $
+  { 50, 10, 14, 12, 0, 0 }, // %
+  { 70, 10, 14, 12, 0, 0 }, // &
+  { 90, 4, 6, 6, 0, 0 }, // '
+  { 94, 6, 14, 8, 0, 0 }, // (
+  { 106, 6, 14, 8, 0, 0 }, // )
+  { 118, 10, 10, 12, 0, 2 }, // *
+  { 138, 10, 10, 12, 0, 2 }, // +
+  { 158, 4, 6, 6, 0, 8 }, // ,
+  { 162, 10, 2, 12, 0, 6 }, // -
+  { 172, 4, 4, 6, 0, 10 }, // .
+  { 176, 10, 10, 12, 0, 2 }, // /
+  { 196, 10, 14, 12, 0, 0 }, // 0
+  { 216, 6, 14, 8, 0, 0 }, // 1
+  { 228, 10, 14, 12, 0, 0 }, // 2
+  { 248, 10, 14, 12, 0, 0 }, // 3
+  { 268, 10, 14, 12, 0, 0 }, // 4
+  { 288, 10, 14, 12, 0, 0 }, // 5
+  { 308, 10, 14, 12, 0, 0 }, // 6
+  { 328, 10, 14, 12, 0, 0 }, // 7
+  { 348, 10, 14, 12, 0, 0 }, // 8
+  { 368, 10, 14, 12, 0, 0 }, // 9
+  { 388, 4, 10, 6, 0, 2 }, // :
+  { 396, 4, 12, 6, 0, 2 }, // ;
+  { 404, 8, 14, 10, 0, 0 }, // <
+  { 420, 10, 6, 12, 0, 4 }, // =
+  { 430, 8, 14, 10, 0, 0 }, // >
+  { 446, 10, 14, 12, 0, 0 }, // ?
+  { 466, 10, 14, 12, 0, 0 }, // @
+  { 486, 10, 14, 12, 0, 0 }, // A
+  { 506, 10, 14, 12, 0, 0 }, // B
+  { 526, 10, 14, 12, 0, 0 }, // C
+  { 546, 10, 14, 12, 0, 0 }, // D
+  { 566, 10, 14, 12, 0, 0 }, // E
+  { 586, 10, 14, 12, 0, 0 }, // F
+  { 606, 10, 14, 12, 0, 0 }, // G
+  { 626, 10, 14, 12, 0, 0 }, // H
+  { 646, 6, 14, 8, 0, 0 }, // I
+  { 658, 10, 14, 12, 0, 0 }, // J
+  { 678, 10, 14, 12, 0, 0 }, // K
+  { 698, 10, 14, 12, 0, 0 }, // L
+  { 718, 10, 14, 12, 0, 0 }, // M
+  { 738, 10, 14, 12, 0, 0 }, // N
+  { 758, 10, 14, 12, 0, 0 }, // O
+  { 778, 10, 14, 12, 0, 0 }, // P
+  { 798, 10, 14, 12, 0, 0 }, // Q
+  { 818, 10, 14, 12, 0, 0 }, // R
+  { 838, 10, 14, 12, 0, 0 }, // S
+  { 858, 10, 14, 12, 0, 0 }, // T
+  { 878, 10, 14, 12, 0, 0 }, // U
+  { 898, 10, 14, 12, 0, 0 }, // V
+  { 918, 10, 14, 12, 0, 0 }, // W
+  { 938, 10, 14, 12, 0, 0 }, // X
+  { 958, 10, 14, 12, 0, 0 }, // Y
+  { 978, 10, 14, 12, 0, 0 }, // Z
+  { 998, 6, 14, 8, 0, 0 }, // [
+  { 1010, 10, 10, 12, 0, 2 }, // barra invertida
+  { 1030, 6, 14, 8, 0, 0 }, // ]
+  { 1042, 10, 6, 12, 0, 0 }, // ^
+  { 1052, 10, 2, 12, 0, 12 }, // _
+  { 1062, 6, 6, 8, 0, 0 }, // `
+  { 1068, 10, 10, 12, 0, 4 }, // a
+  { 1088, 10, 14, 12, 0, 0 }, // b
+  { 1108, 10, 10, 12, 0, 4 }, // c
+  { 1128, 10, 14, 12, 0, 0 }, // d
+  { 1148, 10, 10, 12, 0, 4 }, // e
+  { 1168, 10, 14, 12, 0, 0 }, // f
+  { 1188, 10, 12, 12, 0, 2 }, // g
+  { 1208, 10, 14, 12, 0, 0 }, // h
+  { 1228, 6, 14, 8, 0, 0 }, // i
+  { 1240, 8, 14, 10, 0, 0 }, // j
+  { 1256, 8, 14, 10, 0, 0 }, // k
+  { 1272, 6, 14, 8, 0, 0 }, // l
+  { 1284, 10, 10, 12, 0, 4 }, // m
+  { 1304, 10, 10, 12, 0, 4 }, // n
+  { 1324, 10, 10, 12, 0, 4 }, // o
+  { 1344, 10, 10, 12, 0, 4 }, // p
+  { 1364, 10, 10, 12, 0, 4 }, // q
+  { 1384, 10, 10, 12, 0, 4 }, // r
+  { 1404, 10, 10, 12, 0, 4 }, // s
+  { 1424, 10, 14, 12, 0, 0 }, // t
+  { 1444, 10, 10, 12, 0, 4 }, // u
+  { 1464, 10, 10, 12, 0, 4 }, // v
+  { 1484, 10, 10, 12, 0, 4 }, // w
+  { 1504, 10, 10, 12, 0, 4 }, // x
+  { 1524, 10, 10, 12, 0, 4 }, // y
+  { 1544, 10, 10, 12, 0, 4 }, // z
+  { 1564, 6, 14, 8, 0, 0 }, // {
+  { 1576, 2, 14, 4, 0, 0 }, // |
+  { 1580, 6, 14, 8, 0, 0 }, // }
+  { 1592, 10, 6, 12, 0, 4 }, // ~
+};
+
+const font_t font_5x7_x2 = {
+  .bitmap = font_5x7_x2_bitmap,
+  .glyphs = font_5x7_x2_glyphs,
+  .first = 32,
+  .last = 126,
+  .fallback = 63,
+  .line_height = 16,
+};
@@ -0,0 +1,160 @@
+// Fonte 8x8 original do projeto (A-Z, 0-9, "camil") e o "!" de 16x16,
+// no formato de inc/fonts.h. Fica em flash (const) com uma unica definicao.
+#include "../fonts.h"
+
+static const uint8_t font_8x8_bitmap[] = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // vazio
+  0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00, // 0
+  0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00, // 1
+  0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00, // 2
+  0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 3
+  0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00, // 4
+  0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // 5
+  0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, // 6
+  0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00, // 7
+  0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 8
+  0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00, // 9
+  0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00, // A
+  0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00, // B
+  0x7e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x00, // C
+  0x7f, 0x41, 0x41, 0x41, 0x41, 0x41, 0x7e, 0x00, // D
+  0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x00, // E
+  0x7f, 0x09, 0x09, 0x09, 0x09, 0x01, 0x01, 0x00, // F
+  0x7f, 0x41, 0x41, 0x41, 0x51, 0x51, 0x73, 0x00, // G
+  0x7f, 0x08, 0x08, 0x08, 0x08, 0x08, 0x7f, 0x00, // H
+  0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, // I
+  0x21, 0x41, 0x41, 0x3f, 0x01, 0x01, 0x01, 0x00, // J
+  0x00, 0x7f, 0x08, 0x08, 0x14, 0x22, 0x41, 0x00, // K
+  0x7f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, // L
+  0x7f, 0x02, 0x04, 0x08, 0x04, 0x02, 0x7f, 0x00, // M
+  0x7f, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7f, 0x00, // N
+  0x3e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x3e, 0x00, // O
+  0x7f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00, // P
+  0x3e, 0x41, 0x41, 0x49, 0x51, 0x61, 0x7e, 0x00, // Q
+  0x7f, 0x11, 0x11, 0x11, 0x31, 0x51, 0x0e, 0x00, // R
+  0x46, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // S
+  0x01, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x01, 0x00, // T
+  0x3f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x3f, 0x00, // U
+  0x0f, 0x10, 0x20, 0x40, 0x20, 0x10, 0x0f, 0x00, // V
+  0x7f, 0x20, 0x10, 0x08, 0x10, 0x20, 0x7f, 0x00, // W
+  0x00, 0x41, 0x22, 0x14, 0x14, 0x22, 0x41, 0x00, // X
+  0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01, 0x00, // Y
+  0x41, 0x61, 0x59, 0x45, 0x43, 0x41, 0x00, 0x00, // Z
+  0x38, 0x44, 0x44, 0x44, 0x44, 0x28, 0x00, 0x00, // c
+  0x20, 0x54, 0x54, 0x54, 0x78, 0x40, 0x00, 0x00, // a
+  0x7c, 0x08, 0x04, 0x04, 0x08, 0x7c, 0x00, 0x00, // m
+  0x00, 0x00, 0x44, 0x7d, 0x40, 0x00, 0x00, 0x00, // i
+  0x00, 0x41, 0x7f, 0x40, 0x00, 0x00, 0x00, 0x00, // l
+  // "!" 16x16: 16 colunas de 2 paginas
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xff, 0xef, 0xff, 0xef, 0xff, 0xef,
+  0xff, 0xef, 0xff, 0xef, 0xff, 0xef, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static const font_glyph_t font_8x8_glyphs[] = {
+  { 0, 8, 8, 8, 0, 0 }, // espaco
+  { 336, 16, 16, 16, 0, 0 }, // !
+  { 0, 8, 8, 8, 0, 0 }, // "
+  { 0, 8, 8, 8, 0, 0 }, // #
+  { 0, 8, 8, 8, 0, 0 }, // $
+  { 0, 8, 8, 8, 0, 0 }, // %
+  { 0, 8, 8, 8, 0, 0 }, // &
+  { 0, 8, 8, 8, 0, 0 }, // '
+  { 0, 8, 8, 8, 0, 0 }, // (
+  { 0, 8, 8, 8, 0, 0 }, // )
+  { 0, 8, 8, 8, 0, 0 }, // *
+  { 0, 8, 8, 8, 0, 0 }, // +
+  { 0, 8, 8, 8, 0, 0 }, // ,
+  { 0, 8, 8, 8, 0, 0 }, // -
+  { 0, 8, 8, 8, 0, 0 }, // .
+  { 0, 8, 8, 8, 0, 0 }, // /
+  { 8, 8, 8, 8, 0, 0 }, // 0
+  { 16, 8, 8, 8, 0, 0 }, // 1
+  { 24, 8, 8, 8, 0, 0 }, // 2
+  { 32, 8, 8, 8, 0, 0 }, // 3
+  { 40, 8, 8, 8, 0, 0 }, // 4
+  { 48, 8, 8, 8, 0, 0 }, // 5
+  { 56, 8, 8, 8, 0, 0 }, // 6
+  { 64, 8, 8, 8, 0, 0 }, // 7
+  { 72, 8, 8, 8, 0, 0 }, // 8
+  { 80, 8, 8, 8, 0, 0 }, // 9
+  { 0, 8, 8, 8, 0, 0 }, // :
+  { 0, 8, 8, 8, 0, 0 }, // ;
+  { 0, 8, 8, 8, 0, 0 }, // <
+  { 0, 8, 8, 8, 0, 0 }, // =
+  { 0, 8, 8, 8, 0, 0 }, // >
+  { 0, 8, 8, 8, 0, 0 }, // ?
+  { 0, 8, 8, 8, 0, 0 }, // @
+  { 88, 8, 8, 8, 0, 0 }, // A
+  { 96, 8, 8, 8, 0, 0 }, // B
+  { 104, 8, 8, 8, 0, 0 }, // C
+  { 112, 8, 8, 8, 0, 0 }, // D
+  { 120, 8, 8, 8, 0, 0 }, // E
+  { 128, 8, 8, 8, 0, 0 }, // F
+  { 136, 8, 8, 8, 0, 0 }, // G
+  { 144, 8, 8, 8, 0, 0 }, // H
+  { 152, 8, 8, 8, 0, 0 }, // I
+  { 160, 8, 8, 8, 0, 0 }, // J
+  { 168, 8, 8, 8, 0, 0 }, // K
+  { 176, 8, 8, 8, 0, 0 }, // L
+  { 184, 8, 8, 8, 0, 0 }, // M
+  { 192, 8, 8, 8, 0, 0 }, // N
+  { 200, 8, 8, 8, 0, 0 }, // O
+  { 208, 8, 8, 8, 0, 0 }, // P
+  { 216, 8, 8, 8, 0, 0 }, // Q
+  { 224, 8, 8, 8, 0, 0 }, // R
+  { 232, 8, 8, 8, 0, 0 }, // S
+  { 240, 8, 8, 8, 0, 0 }, // T
+  { 248, 8, 8, 8, 0, 0 }, // U
+  { 256, 8, 8, 8, 0, 0 }, // V
+  { 264, 8, 8, 8, 0, 0 }, // W
+  { 272, 8, 8, 8, 0, 0 }, // X
+  { 280, 8, 8, 8, 0, 0 }, // Y
+  { 288, 8, 8, 8, 0, 0 }, // Z
+  { 0, 8, 8, 8, 0, 0 }, // [
+  { 0, 8, 8, 8, 0, 0 }, // barra invertida
+  { 0, 8, 8, 8, 0, 0 }, // ]
+  { 0, 8, 8, 8, 0, 0 }, // ^
+  { 0, 8, 8, 8, 0, 0 }, // _
+  { 0, 8, 8, 8, 0, 0 }, // `
+  { 304, 8, 8, 8, 0, 0 }, // a
+  { 0, 8, 8, 8, 0, 0 }, // b
+  { 296, 8, 8, 8, 0, 0 }, // c
+  { 0, 8, 8, 8, 0, 0 }, // d
+  { 0, 8, 8, 8, 0, 0 }, // e
+  { 0, 8, 8, 8, 0, 0 }, // f
+  { 0, 8, 8, 8, 0, 0 }, // g
+  { 0, 8, 8, 8, 0, 0 }, // h
+  { 320, 8, 8, 8, 0, 0 }, // i
+  { 0, 8, 8, 8, 0, 0 }, // j
+  { 0, 8, 8, 8, 0, 0 }, // k
+  { 328, 8, 8, 8, 0, 0 }, // l
+  { 312, 8, 8, 8, 0, 0 }, // m
+  { 0, 8, 8, 8, 0, 0 }, // n
+  { 0, 8, 8, 8, 0, 0 }, // o
+  { 0, 8, 8, 8, 0, 0 }, // p
+  { 0, 8, 8, 8, 0, 0 }, // q
+  { 0, 8, 8, 8, 0, 0 }, // r
+  { 0, 8, 8, 8, 0, 0 }, // s
+  { 0, 8, 8, 8, 0, 0 }, // t
+  { 0, 8, 8, 8, 0, 0 }, // u
+  { 0, 8, 8, 8, 0, 0 }, // v
+  { 0, 8, 8, 8, 0, 0 }, // w
+  { 0, 8, 8, 8, 0, 0 }, // x
+  { 0, 8, 8, 8, 0, 0 }, // y
+  { 0, 8, 8, 8, 0, 0 }, // z
+  { 0, 8, 8, 8, 0, 0 }, // {
+  { 0, 8, 8, 8, 0, 0 }, // |
+  { 0, 8, 8, 8, 0, 0 }, // }
+  { 0, 8, 8, 8, 0, 0 }, // ~
+};
+
+const font_t font_8x8 = {
+  .bitmap = font_8x8_bitmap,
+  .glyphs = font_8x8_glyphs,
+  .first = 32,
+  .last = 126,
+  .fallback = 32,
+  .line_height = 8,
+};
@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <string.h>
+#include "frame_profiler.h"
+
+void frame_profiler_init(frame_profiler_t *p, uint32_t window_us, uint32_t now) {
+  memset(p, 0, sizeof(*p));
+  p->window_us = window_us;
+  p->window_start = now;
+  p->stale = true;
+}
+
+void frame_profiler_frame(frame_profiler_t *p, uint32_t render_us, uint32_t overruns, uint32_t now) {
+  p->frames++;
+  p->render_sum += render_us;
+  uint32_t elapsed = now - p->window_start;
+  if (elapsed < p->window_us)
+    return;
+
+  // Medias da janela, arredondadas
+  p->fps = (uint32_t)(((uint64_t)p->frames * 1000000u + elapsed / 2) / elapsed);
+  p->render_us = (p->render_sum + p->frames / 2) / p->frames;
+  p->bus_us = p->bus_count ? (p->bus_sum + p->bus_count / 2) / p->bus_count : 0;
+  p->overruns = overruns - p->overruns_start;
+  p->overruns_start = overruns;
+  p->frames = p->render_sum = p->bus_sum = p->bus_count = 0;
+  p->window_start = now;
+  p->stale = true;
+}
+
+void frame_profiler_draw(frame_profiler_t *p, ssd1306_t *ssd, int16_t x, uint8_t page) {
+  if (p->stale) {
+    // Texto novo sobre fundo apagado, guardado para os proximos quadros
+    char text[64];
+    snprintf(text, sizeof(text), "%lufps r%luus\ni%luus o%lu", (unsigned long)p->fps,
+             (unsigned long)p->render_us, (unsigned long)p->bus_us, (unsigned long)p->overruns);
+    int16_t y = page << 3;
+    ssd1306_fill_rect(ssd, y, x, FRAME_PROFILER_WIDTH, FRAME_PROFILER_PAGES << 3, false);
+    ssd1306_set_clip(ssd, x, y, x + FRAME_PROFILER_WIDTH - 1, y + (FRAME_PROFILER_PAGES << 3) - 1);
+    ssd1306_draw_text(ssd, &font_5x7, text, x + 1, y);
+    ssd1306_reset_clip(ssd);
+    ssd1306_read_pages(ssd, x, page, FRAME_PROFILER_WIDTH, FRAME_PROFILER_PAGES, p->block);
+    p->stale = false;
+    return;
+  }
+  ssd1306_write_pages(ssd, x, page, FRAME_PROFILER_WIDTH, FRAME_PROFILER_PAGES, p->block);
+}
@@ -0,0 +1,45 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+// Bloco da sobreposicao: duas linhas da fonte 5x7 em paginas inteiras
+#define FRAME_PROFILER_WIDTH 64
+#define FRAME_PROFILER_PAGES 2
+
+// Contadores do display por janela (tipicamente 1 s): quadros, tempo de
+// desenho, tempo de transmissao e atrasos do laco. Tudo pertence ao dono do
+// display. A sobreposicao so e redesenhada com texto quando a janela fecha;
+// nos outros quadros o bloco guardado e copiado para o framebuffer.
+typedef struct {
+  uint32_t window_us;
+  uint32_t window_start;
+  uint32_t frames;          // Quadros na janela atual
+  uint32_t render_sum;
+  uint32_t bus_sum, bus_count;
+  uint32_t overruns_start;  // Total de atrasos no inicio da janela
+
+  // Resultados da ultima janela fechada
+  uint32_t fps, render_us, bus_us, overruns;
+  bool stale;               // Texto do bloco desatualizado
+  uint8_t block[FRAME_PROFILER_WIDTH * FRAME_PROFILER_PAGES];
+} frame_profiler_t;
+
+void frame_profiler_init(frame_profiler_t *p, uint32_t window_us, uint32_t now);
+
+// Um quadro desenhado em render_us; overruns e o total acumulado de atrasos
+// do laco. Fecha a janela quando window_us tiver passado.
+void frame_profiler_frame(frame_profiler_t *p, uint32_t render_us, uint32_t overruns, uint32_t now);
+
+// Fim de uma transmissao de quadro que durou bus_us
+static inline void frame_profiler_bus(frame_profiler_t *p, uint32_t bus_us) {
+  p->bus_sum += bus_us;
+  p->bus_count++;
+}
+
+// Sobreposicao na coluna x, a partir da pagina page
+void frame_profiler_draw(frame_profiler_t *p, ssd1306_t *ssd, int16_t x, uint8_t page);
+
+#endif
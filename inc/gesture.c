@@ -0,0 +1,101 @@
+#include "gesture.h"
+
+enum {
+  GESTURE_IDLE,
+  GESTURE_PRESSED,        // Primeiro pressionar; prazo = long press
+  GESTURE_HELD,           // Long press emitido; prazo = proxima repeticao
+  GESTURE_WAIT_SECOND,    // Solto apos um clique; prazo = fim da janela
+  GESTURE_PRESSED_SECOND, // Segundo pressionar dentro da janela
+  GESTURE_IGNORE_RELEASE, // Pressionar consumido; espera soltar sem gesto
+};
+
+static void gesture_arm(gesture_button_t *b, uint32_t deadline_us) {
+  b->armed = true;
+  b->deadline_us = deadline_us;
+}
+
+// Prazo vencido, com comparacao tolerante a volta do contador de 32 bits
+static bool gesture_expired(const gesture_button_t *b, uint32_t now_us) {
+  return b->armed && (int32_t)(now_us - b->deadline_us) >= 0;
+}
+
+void gesture_init(gesture_button_t *b, const gesture_config_t *config) {
+  b->config = config;
+  b->state = GESTURE_IDLE;
+  b->armed = false;
+  b->deadline_us = 0;
+}
+
+gesture_t gesture_event(gesture_button_t *b, bool pressed, uint32_t time_us) {
+  // Prazos vencidos antes deste evento valem primeiro (o evento pode chegar
+  // antes de gesture_update ter rodado)
+  gesture_t expired = gesture_update(b, time_us);
+  if (expired == GESTURE_LONG_PRESS) {
+    if (!pressed) {
+      // Soltou no mesmo instante em que venceu o long press
+      b->state = GESTURE_IDLE;
+      b->armed = false;
+    }
+    return expired;
+  }
+
+  if (pressed) {
+    if (b->state == GESTURE_WAIT_SECOND) {
+      b->state = GESTURE_PRESSED_SECOND;
+      b->armed = false;
+    } else {
+      b->state = GESTURE_PRESSED;
+      gesture_arm(b, time_us + b->config->long_press_us);
+    }
+    return expired;
+  }
+
+  switch (b->state) {
+    case GESTURE_PRESSED:
+      if (b->config->double_click_us) {
+        b->state = GESTURE_WAIT_SECOND;
+        gesture_arm(b, time_us + b->config->double_click_us);
+        return expired;
+      }
+      b->state = GESTURE_IDLE;
+      b->armed = false;
+      return GESTURE_CLICK;
+    case GESTURE_PRESSED_SECOND:
+      b->state = GESTURE_IDLE;
+      return GESTURE_DOUBLE_CLICK;
+    default:
+      b->state = GESTURE_IDLE;
+      b->armed = false;
+      return expired;
+  }
+}
+
+gesture_t gesture_update(gesture_button_t *b, uint32_t now_us) {
+  if (!gesture_expired(b, now_us))
+    return GESTURE_NONE;
+
+  switch (b->state) {
+    case GESTURE_PRESSED:
+      if (b->config->repeat_us) {
+        b->state = GESTURE_HELD;
+        gesture_arm(b, b->deadline_us + b->config->repeat_us);
+      } else {
+        b->state = GESTURE_IGNORE_RELEASE;
+        b->armed = false;
+      }
+      return GESTURE_LONG_PRESS;
+    case GESTURE_HELD:
+      // Uma repeticao por chamada; atrasos longos nao geram rajadas
+      b->deadline_us += b->config->repeat_us;
+      if ((int32_t)(now_us - b->deadline_us) >= 0)
+        b->deadline_us = now_us + b->config->repeat_us;
+      return GESTURE_REPEAT;
+    case GESTURE_WAIT_SECOND:
+      b->state = GESTURE_IDLE;
+      b->armed = false;
+      return GESTURE_CLICK;
+    default:
+      b->armed = false;
+      return GESTURE_NONE;
+  }
+}
@@ -0,0 +1,38 @@
+#ifndef GESTURE_H
+#define GESTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+  GESTURE_NONE,
+  GESTURE_CLICK,
+  GESTURE_DOUBLE_CLICK,
+  GESTURE_LONG_PRESS,   // Botao mantido por long_press_us
+  GESTURE_REPEAT,       // A cada repeat_us depois do long press, enquanto mantido
+} gesture_t;
+
+// Tempos em us; double_click_us = 0 emite o clique ja ao soltar e
+// repeat_us = 0 desativa a repeticao
+typedef struct {
+  uint32_t double_click_us;
+  uint32_t long_press_us;
+  uint32_t repeat_us;
+} gesture_config_t;
+
+// Reconhecedor de um botao, alimentado com pressionar/soltar ja sem bounce.
+// Cada chamada e O(1) e gera no maximo um gesto. Os prazos (long press,
+// repeticao, fim da janela de duplo clique) sao verificados em
+// gesture_update, com o relogio passado pelo chamador.
+typedef struct {
+  const gesture_config_t *config;
+  uint8_t state;
+  bool armed;             // deadline_us valido
+  uint32_t deadline_us;
+} gesture_button_t;
+
+void gesture_init(gesture_button_t *b, const gesture_config_t *config);
+gesture_t gesture_event(gesture_button_t *b, bool pressed, uint32_t time_us);
+gesture_t gesture_update(gesture_button_t *b, uint32_t now_us);
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Camada fina sobre o hardware usado pela aplicacao (tempo, GPIO, PWM, ADC,
+// I2C, timers periodicos e console). hal_pico.c implementa sobre o pico-sdk;
+// hal_host.c (HAL_HOST=1) simula tudo no Linux para o alvo AtividadeADC_host.
+#ifndef HAL_HOST
+#define HAL_HOST 0
+#endif
+
+// Bordas dos eventos de entrada (mesmos valores de GPIO_IRQ_EDGE_*)
+#define HAL_EDGE_FALL 0x4u
+#define HAL_EDGE_RISE 0x8u
+
+typedef bool (*hal_timer_fn_t)(void *user);
+
+#if HAL_HOST
+
+typedef unsigned int uint;
+typedef struct hal_i2c hal_i2c_t;
+
+#ifndef count_of
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#endif
+
+// Timer periodico simulado; dispara em hal_wait_event/hal_sleep_*
+typedef struct hal_timer {
+  uint32_t period_us;
+  uint32_t deadline_us;
+  hal_timer_fn_t fn;
+  void *user;
+  bool active;
+  struct hal_timer *next;
+} hal_timer_t;
+
+#else
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+typedef i2c_inst_t hal_i2c_t;
+
+typedef struct {
+  repeating_timer_t timer;
+  hal_timer_fn_t fn;
+  void *user;
+} hal_timer_t;
+
+#endif
+
+void hal_init(void);
+
+// Tempo
+uint32_t hal_time_us(void);
+void hal_sleep_ms(uint32_t ms);
+void hal_sleep_until_us(uint32_t deadline_us);
+// Espera ate a proxima interrupcao (WFE no RP2040)
+void hal_wait_event(void);
+// Corpo de laços de espera ativa
+void hal_idle(void);
+
+// GPIO
+void hal_gpio_input_pullup(uint pin);
+void hal_gpio_output(uint pin);
+void hal_gpio_put(uint pin, bool value);
+bool hal_gpio_get(uint pin);
+uint32_t hal_gpio_get_all(void);
+
+// PWM de 16 bits por pino
+void hal_pwm_init(uint pin, uint16_t wrap);
+void hal_pwm_set(uint pin, uint16_t level);
+
+// ADC: configura o pino (26-29) como entrada analogica
+void hal_adc_init(uint pin);
+uint16_t hal_adc_read(uint channel);
+
+// I2C: barramento `index` (0 ou 1) nos pinos sda/scl
+hal_i2c_t *hal_i2c_init(uint index, uint32_t baudrate, uint sda, uint scl);
+int hal_i2c_write(hal_i2c_t *i2c, uint8_t address, const uint8_t *src, size_t len, bool nostop);
+
+// Timer periodico; o callback roda em contexto de interrupcao e retorna
+// false para parar. O periodo conta do inicio do callback anterior.
+bool hal_timer_start(hal_timer_t *timer, uint32_t period_us, hal_timer_fn_t fn, void *user);
+void hal_timer_stop(hal_timer_t *timer);
+
+// Console: proximo caractere recebido ou -1 se nao houver
+int hal_console_getc(void);
+// Bytes crus no console, sem traducao de fim de linha (dados binarios)
+void hal_console_write(const void *data, size_t len);
+
+#if HAL_HOST
+// Controle da simulacao (somente no host)
+typedef void (*hal_host_i2c_sink_t)(void *user, uint8_t address, const uint8_t *data, size_t len, bool nostop);
+
+// Relogio virtual: o tempo so avanca em esperas e em hal_host_advance_us
+void hal_host_set_virtual_clock(bool virtual_clock);
+void hal_host_advance_us(uint32_t us);
+void hal_host_set_gpio(uint pin, bool value);
+bool hal_host_gpio_output(uint pin);
+uint16_t hal_host_pwm_level(uint pin);
+void hal_host_set_adc(uint channel, uint16_t value);
+void hal_host_set_i2c_sink(hal_host_i2c_sink_t sink, void *user);
+#endif
+
+#endif
@@ -0,0 +1,243 @@
+#define _POSIX_C_SOURCE 200809L
+#include <poll.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include "hal.h"
+
+// Estado simulado do hardware
+static bool virtual_clock = false;
+static uint64_t virtual_now_us = 0;
+static struct timespec clock_origin;
+static hal_timer_t *timers = NULL;
+static uint32_t gpio_inputs = 0xFFFFFFFFu;   // Pull-ups: tudo em nivel alto
+static uint32_t gpio_outputs = 0;
+static uint16_t pwm_levels[30];
+static uint16_t adc_values[5] = { 2048, 2048, 2048, 2048, 2048 };
+static hal_host_i2c_sink_t i2c_sink = NULL;
+static void *i2c_sink_user = NULL;
+
+struct hal_i2c {
+  uint index;
+  uint32_t baudrate;
+};
+static struct hal_i2c i2c_buses[2] = { { 0, 0 }, { 1, 0 } };
+
+static uint64_t real_now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)(ts.tv_sec - clock_origin.tv_sec) * 1000000u +
+         (ts.tv_nsec - clock_origin.tv_nsec) / 1000;
+}
+
+static uint64_t now_us(void) {
+  return virtual_clock ? virtual_now_us : real_now_us();
+}
+
+void hal_init(void) {
+  clock_gettime(CLOCK_MONOTONIC, &clock_origin);
+  // Saida por linha, como o stdio USB, mesmo redirecionada para arquivo ou pipe
+  setvbuf(stdout, NULL, _IOLBF, 0);
+}
+
+uint32_t hal_time_us(void) {
+  return (uint32_t)now_us();
+}
+
+// Timer ativo com o prazo mais proximo
+static hal_timer_t *hal_next_timer(void) {
+  hal_timer_t *next = NULL;
+  for (hal_timer_t *t = timers; t; t = t->next)
+    if (t->active && (!next || (int32_t)(t->deadline_us - next->deadline_us) < 0))
+      next = t;
+  return next;
+}
+
+static void hal_unlink_timer(hal_timer_t *timer) {
+  for (hal_timer_t **p = &timers; *p; p = &(*p)->next) {
+    if (*p == timer) {
+      *p = timer->next;
+      break;
+    }
+  }
+  timer->active = false;
+}
+
+static void hal_fire(hal_timer_t *timer) {
+  if (timer->fn(timer->user))
+    timer->deadline_us += timer->period_us;
+  else
+    hal_unlink_timer(timer);
+}
+
+static void hal_sleep_real(uint64_t until_us) {
+  uint64_t now = real_now_us();
+  if (until_us <= now)
+    return;
+  uint64_t us = until_us - now;
+  struct timespec ts = { (time_t)(us / 1000000u), (long)(us % 1000000u) * 1000 };
+  nanosleep(&ts, NULL);
+}
+
+// Avanca o tempo ate `target`, disparando os timers vencidos em ordem, como
+// se as IRQs interrompessem a espera
+static void hal_advance_to(uint64_t target) {
+  for (;;) {
+    hal_timer_t *t = hal_next_timer();
+    uint64_t now = now_us();
+    if (!t || (int32_t)(t->deadline_us - (uint32_t)target) > 0)
+      break;
+    int32_t wait = (int32_t)(t->deadline_us - (uint32_t)now);
+    if (wait > 0) {
+      if (virtual_clock)
+        virtual_now_us = now + wait;
+      else
+        hal_sleep_real(now + wait);
+    }
+    hal_fire(t);
+  }
+  if (virtual_clock) {
+    if (target > virtual_now_us)
+      virtual_now_us = target;
+  } else {
+    hal_sleep_real(target);
+  }
+}
+
+void hal_sleep_ms(uint32_t ms) {
+  hal_advance_to(now_us() + (uint64_t)ms * 1000u);
+}
+
+void hal_sleep_until_us(uint32_t deadline_us) {
+  int32_t remaining = (int32_t)(deadline_us - hal_time_us());
+  if (remaining > 0)
+    hal_advance_to(now_us() + remaining);
+}
+
+// Sem timers ativos nenhum evento chegaria; avanca 1 ms para nao travar
+void hal_wait_event(void) {
+  hal_timer_t *t = hal_next_timer();
+  uint64_t now = now_us();
+  int32_t wait = t ? (int32_t)(t->deadline_us - (uint32_t)now) : 1000;
+  hal_advance_to(now + (wait > 0 ? wait : 0));
+}
+
+void hal_idle(void) {
+}
+
+void hal_gpio_input_pullup(uint pin) {
+  gpio_inputs |= 1u << pin;
+}
+
+void hal_gpio_output(uint pin) {
+  gpio_outputs &= ~(1u << pin);
+}
+
+void hal_gpio_put(uint pin, bool value) {
+  if (value)
+    gpio_outputs |= 1u << pin;
+  else
+    gpio_outputs &= ~(1u << pin);
+}
+
+bool hal_gpio_get(uint pin) {
+  return (gpio_inputs >> pin) & 1;
+}
+
+uint32_t hal_gpio_get_all(void) {
+  return gpio_inputs;
+}
+
+void hal_pwm_init(uint pin, uint16_t wrap) {
+  (void)wrap;
+  pwm_levels[pin] = 0;
+}
+
+void hal_pwm_set(uint pin, uint16_t level) {
+  pwm_levels[pin] = level;
+}
+
+void hal_adc_init(uint pin) {
+  (void)pin;
+}
+
+uint16_t hal_adc_read(uint channel) {
+  return adc_values[channel];
+}
+
+hal_i2c_t *hal_i2c_init(uint index, uint32_t baudrate, uint sda, uint scl) {
+  (void)sda;
+  (void)scl;
+  hal_i2c_t *i2c = &i2c_buses[index ? 1 : 0];
+  i2c->baudrate = baudrate;
+  return i2c;
+}
+
+int hal_i2c_write(hal_i2c_t *i2c, uint8_t address, const uint8_t *src, size_t len, bool nostop) {
+  (void)i2c;
+  if (i2c_sink)
+    i2c_sink(i2c_sink_user, address, src, len, nostop);
+  return (int)len;
+}
+
+bool hal_timer_start(hal_timer_t *timer, uint32_t period_us, hal_timer_fn_t fn, void *user) {
+  timer->period_us = period_us;
+  timer->deadline_us = hal_time_us() + period_us;
+  timer->fn = fn;
+  timer->user = user;
+  timer->active = true;
+  timer->next = timers;
+  timers = timer;
+  return true;
+}
+
+void hal_timer_stop(hal_timer_t *timer) {
+  hal_unlink_timer(timer);
+}
+
+int hal_console_getc(void) {
+  struct pollfd fd = { STDIN_FILENO, POLLIN, 0 };
+  unsigned char c;
+  if (poll(&fd, 1, 0) > 0 && read(STDIN_FILENO, &c, 1) == 1)
+    return c;
+  return -1;
+}
+
+void hal_console_write(const void *data, size_t len) {
+  fwrite(data, 1, len, stdout);
+  fflush(stdout);
+}
+
+void hal_host_set_virtual_clock(bool enabled) {
+  if (enabled && !virtual_clock)
+    virtual_now_us = real_now_us();
+  virtual_clock = enabled;
+}
+
+void hal_host_advance_us(uint32_t us) {
+  hal_advance_to(now_us() + us);
+}
+
+void hal_host_set_gpio(uint pin, bool value) {
+  if (value)
+    gpio_inputs |= 1u << pin;
+  else
+    gpio_inputs &= ~(1u << pin);
+}
+
+bool hal_host_gpio_output(uint pin) {
+  return (gpio_outputs >> pin) & 1;
+}
+
+uint16_t hal_host_pwm_level(uint pin) {
+  return pwm_levels[pin];
+}
+
+void hal_host_set_adc(uint channel, uint16_t value) {
+  adc_values[channel] = value;
+}
+
+void hal_host_set_i2c_sink(hal_host_i2c_sink_t sink, void *user) {
+  i2c_sink = sink;
+  i2c_sink_user = user;
+}
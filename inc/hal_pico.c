@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include "hardware/adc.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+#include "hal.h"
+
+void hal_init(void) {
+  stdio_init_all();
+}
+
+uint32_t hal_time_us(void) {
+  return time_us_32();
+}
+
+void hal_sleep_ms(uint32_t ms) {
+  sleep_ms(ms);
+}
+
+void hal_sleep_until_us(uint32_t deadline_us) {
+  int32_t remaining = (int32_t)(deadline_us - time_us_32());
+  if (remaining > 0)
+    sleep_us(remaining);
+}
+
+void hal_wait_event(void) {
+  __wfe();
+}
+
+void hal_idle(void) {
+  tight_loop_contents();
+}
+
+void hal_gpio_input_pullup(uint pin) {
+  gpio_init(pin);
+  gpio_set_dir(pin, GPIO_IN);
+  gpio_pull_up(pin);
+}
+
+void hal_gpio_output(uint pin) {
+  gpio_init(pin);
+  gpio_set_dir(pin, GPIO_OUT);
+}
+
+void hal_gpio_put(uint pin, bool value) {
+  gpio_put(pin, value);
+}
+
+bool hal_gpio_get(uint pin) {
+  return gpio_get(pin);
+}
+
+uint32_t hal_gpio_get_all(void) {
+  return gpio_get_all();
+}
+
+void hal_pwm_init(uint pin, uint16_t wrap) {
+  gpio_set_function(pin, GPIO_FUNC_PWM);
+  uint slice_num = pwm_gpio_to_slice_num(pin);
+  pwm_set_wrap(slice_num, wrap);
+  pwm_set_enabled(slice_num, true);
+}
+
+void hal_pwm_set(uint pin, uint16_t level) {
+  pwm_set_gpio_level(pin, level);
+}
+
+void hal_adc_init(uint pin) {
+  static bool adc_ready = false;
+  if (!adc_ready) {
+    adc_init();
+    adc_ready = true;
+  }
+  adc_gpio_init(pin);
+}
+
+uint16_t hal_adc_read(uint channel) {
+  adc_select_input(channel);
+  return adc_read();
+}
+
+hal_i2c_t *hal_i2c_init(uint index, uint32_t baudrate, uint sda, uint scl) {
+  i2c_inst_t *i2c = index ? i2c1 : i2c0;
+  i2c_init(i2c, baudrate);
+  gpio_set_function(sda, GPIO_FUNC_I2C);
+  gpio_set_function(scl, GPIO_FUNC_I2C);
+  gpio_pull_up(sda);
+  gpio_pull_up(scl);
+  return i2c;
+}
+
+int hal_i2c_write(hal_i2c_t *i2c, uint8_t address, const uint8_t *src, size_t len, bool nostop) {
+  return i2c_write_blocking(i2c, address, src, len, nostop);
+}
+
+static bool hal_timer_callback(repeating_timer_t *rt) {
+  hal_timer_t *timer = (hal_timer_t *)rt->user_data;
+  return timer->fn(timer->user);
+}
+
+bool hal_timer_start(hal_timer_t *timer, uint32_t period_us, hal_timer_fn_t fn, void *user) {
+  timer->fn = fn;
+  timer->user = user;
+  // Atraso negativo: periodo medido entre inicios de callbacks, sem deriva
+  return add_repeating_timer_us(-(int64_t)period_us, hal_timer_callback, timer, &timer->timer);
+}
+
+void hal_timer_stop(hal_timer_t *timer) {
+  cancel_repeating_timer(&timer->timer);
+}
+
+int hal_console_getc(void) {
+  int c = getchar_timeout_us(0);
+  return c == PICO_ERROR_TIMEOUT ? -1 : c;
+}
+
+void hal_console_write(const void *data, size_t len) {
+  // putchar_raw nao converte \n em \r\n
+  const uint8_t *p = data;
+  for (size_t i = 0; i < len; ++i)
+    putchar_raw(p[i]);
+}
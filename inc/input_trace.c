@@ -0,0 +1,56 @@
+#include <string.h>
+#include "input_trace.h"
+
+static const uint8_t INPUT_TRACE_MAGIC[4] = { 'A', 'J', 'T', 'R' };
+
+void input_trace_header(uint8_t out[INPUT_TRACE_HEADER_SIZE]) {
+  memcpy(out, INPUT_TRACE_MAGIC, 4);
+  out[4] = INPUT_TRACE_VERSION;
+  out[5] = INPUT_TRACE_RECORD_SIZE;
+  out[6] = 0;
+  out[7] = 0;
+}
+
+bool input_trace_check_header(const uint8_t in[INPUT_TRACE_HEADER_SIZE]) {
+  // A versao 1 e a 2 sem registros de salto
+  return memcmp(in, INPUT_TRACE_MAGIC, 4) == 0 && in[4] >= 1 && in[4] <= INPUT_TRACE_VERSION &&
+         in[5] == INPUT_TRACE_RECORD_SIZE;
+}
+
+size_t input_trace_pack(uint32_t *last_us, const input_trace_record_t *rec, uint8_t out[INPUT_TRACE_PACK_MAX]) {
+  uint32_t dt = rec->time_us - *last_us;
+  size_t size = 0;
+  if (dt > 0xFFFF) {
+    out[0] = dt & 0xFF;
+    out[1] = (dt >> 8) & 0xFF;
+    out[2] = (dt >> 16) & 0xFF;
+    out[3] = dt >> 24;
+    out[4] = 0;
+    out[5] = INPUT_TRACE_GAP;
+    out += INPUT_TRACE_RECORD_SIZE;
+    size = INPUT_TRACE_RECORD_SIZE;
+    dt = 0;
+  }
+  *last_us = rec->time_us;
+  uint16_t x = rec->x & 0xFFF, y = rec->y & 0xFFF;
+  out[0] = dt & 0xFF;
+  out[1] = dt >> 8;
+  out[2] = x & 0xFF;
+  out[3] = (x >> 8) | (y << 4);
+  out[4] = y >> 4;
+  out[5] = rec->buttons;
+  return size + INPUT_TRACE_RECORD_SIZE;
+}
+
+bool input_trace_unpack(uint32_t *last_us, const uint8_t in[INPUT_TRACE_RECORD_SIZE], input_trace_record_t *rec) {
+  if (in[5] & INPUT_TRACE_GAP) {
+    *last_us += in[0] | (in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+    return false;
+  }
+  *last_us += in[0] | (in[1] << 8);
+  rec->time_us = *last_us;
+  rec->x = in[2] | ((in[3] & 0x0F) << 8);
+  rec->y = (in[3] >> 4) | (in[4] << 4);
+  rec->buttons = in[5];
+  return true;
+}
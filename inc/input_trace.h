@@ -0,0 +1,75 @@
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal.h"
+
+// Trace de entrada: leituras brutas do ADC (X/Y) e botoes pressionados com
+// instante, gravado pelo firmware (modo de captura) e reproduzido no host.
+//
+// Formato binario (little-endian): cabecalho de 8 bytes ("AJTR", versao,
+// tamanho do registro, 2 reservados) seguido de registros de 6 bytes:
+//   dt_us (16 bits) | x (12 bits) | y (12 bits) | botoes (8 bits)
+// dt_us conta do registro anterior (do inicio da captura no primeiro).
+// Intervalos maiores que 65535 us vao num registro de salto antes do
+// registro normal (que fica com dt_us = 0):
+//   dt_us (32 bits) | 0 (8 bits) | INPUT_TRACE_GAP (8 bits)
+// Traces da versao 1 nao tem saltos e sao lidos do mesmo jeito.
+//
+// Formato texto, para traces escritos a mao: uma linha por registro com
+// "tempo_us x y botoes", tempo absoluto e crescente, botoes "-", "S", "A"
+// ou "SA"; linhas vazias e iniciadas por '#' sao ignoradas.
+//   # joystick em repouso, clique no botao do joystick aos 100 ms
+//   0       2048 2048 -
+//   100000  2048 2048 S
+//   180000  2048 2048 -
+#define INPUT_TRACE_VERSION 2
+#define INPUT_TRACE_HEADER_SIZE 8
+#define INPUT_TRACE_RECORD_SIZE 6
+// Maior saida de input_trace_pack: salto + registro
+#define INPUT_TRACE_PACK_MAX (2 * INPUT_TRACE_RECORD_SIZE)
+
+// Botoes pressionados (nivel baixo no pino)
+#define INPUT_TRACE_SW 0x01u
+#define INPUT_TRACE_BUTTON_A 0x02u
+// Marca de registro de salto no byte dos botoes
+#define INPUT_TRACE_GAP 0x80u
+
+typedef struct {
+  uint32_t time_us;   // Desde o inicio do trace
+  uint16_t x, y;      // Leituras de 12 bits
+  uint8_t buttons;    // INPUT_TRACE_SW | INPUT_TRACE_BUTTON_A
+} input_trace_record_t;
+
+void input_trace_header(uint8_t out[INPUT_TRACE_HEADER_SIZE]);
+bool input_trace_check_header(const uint8_t in[INPUT_TRACE_HEADER_SIZE]);
+
+// Codifica rec relativo a *last_us e atualiza *last_us; devolve os bytes
+// escritos (um registro, ou dois com o salto antes)
+size_t input_trace_pack(uint32_t *last_us, const input_trace_record_t *rec, uint8_t out[INPUT_TRACE_PACK_MAX]);
+// Decodifica um registro e avanca *last_us; false num registro de salto,
+// que so avanca o tempo e nao preenche rec
+bool input_trace_unpack(uint32_t *last_us, const uint8_t in[INPUT_TRACE_RECORD_SIZE], input_trace_record_t *rec);
+
+#if HAL_HOST
+#include <stdio.h>
+
+// Leitura de um arquivo de trace no host (binario ou texto, detectado pelo
+// cabecalho); input_trace_host.c
+typedef struct {
+  FILE *file;
+  bool binary;
+  uint32_t time_us;   // Instante do ultimo registro lido
+  uint32_t line;      // Linha atual (formato texto), para mensagens de erro
+  bool error;
+} input_trace_file_t;
+
+bool input_trace_open(input_trace_file_t *f, const char *path);
+// false no fim do arquivo ou em erro (f->error)
+bool input_trace_read(input_trace_file_t *f, input_trace_record_t *rec);
+void input_trace_close(input_trace_file_t *f);
+#endif
+
+#endif
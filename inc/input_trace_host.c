@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include <string.h>
+#include "input_trace.h"
+
+bool input_trace_open(input_trace_file_t *f, const char *path) {
+  memset(f, 0, sizeof(*f));
+  f->file = fopen(path, "rb");
+  if (!f->file)
+    return false;
+  uint8_t header[INPUT_TRACE_HEADER_SIZE];
+  f->binary = fread(header, 1, sizeof(header), f->file) == sizeof(header) &&
+              input_trace_check_header(header);
+  if (!f->binary)
+    rewind(f->file);
+  return true;
+}
+
+static bool input_trace_read_binary(input_trace_file_t *f, input_trace_record_t *rec) {
+  uint8_t in[INPUT_TRACE_RECORD_SIZE];
+  // Captura interrompida no meio de um registro: o resto e descartado.
+  // Registros de salto so avancam o tempo do proximo
+  do {
+    if (fread(in, 1, sizeof(in), f->file) != sizeof(in))
+      return false;
+  } while (!input_trace_unpack(&f->time_us, in, rec));
+  return true;
+}
+
+static bool input_trace_read_text(input_trace_file_t *f, input_trace_record_t *rec) {
+  char line[128];
+  while (fgets(line, sizeof(line), f->file)) {
+    f->line++;
+    char *p = line + strspn(line, " \t");
+    if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0')
+      continue;
+
+    unsigned long time_us;
+    unsigned x, y;
+    char buttons[4];
+    if (sscanf(p, "%lu %u %u %3s", &time_us, &x, &y, buttons) != 4 || x > 0xFFF || y > 0xFFF ||
+        (uint32_t)time_us < f->time_us) {
+      f->error = true;
+      return false;
+    }
+    rec->time_us = f->time_us = (uint32_t)time_us;
+    rec->x = x;
+    rec->y = y;
+    rec->buttons = 0;
+    for (const char *b = buttons; *b; ++b) {
+      if (*b == 'S')
+        rec->buttons |= INPUT_TRACE_SW;
+      else if (*b == 'A')
+        rec->buttons |= INPUT_TRACE_BUTTON_A;
+      else if (*b != '-') {
+        f->error = true;
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+bool input_trace_read(input_trace_file_t *f, input_trace_record_t *rec) {
+  return f->binary ? input_trace_read_binary(f, rec) : input_trace_read_text(f, rec);
+}
+
+void input_trace_close(input_trace_file_t *f) {
+  if (f->file)
+    fclose(f->file);
+  f->file = NULL;
+}
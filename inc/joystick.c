@@ -0,0 +1,79 @@
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "joystick.h"
+
+// Apenas uma captura por vez: a IRQ do DMA precisa encontrar o anel
+static joystick_t *active;
+
+// O canal A escreve os blocos pares e o B os impares; processa em ordem os
+// blocos terminados desde a ultima interrupcao
+static void joystick_dma_irq(void) {
+  while (true) {
+    uint32_t done = active->ring.written;
+    uint ch = (done & 1) ? active->dma_b : active->dma_a;
+    if (!(dma_hw->ints1 & (1u << ch)))
+      break;
+    dma_hw->ints1 = 1u << ch;
+    // O outro canal ja escreve o bloco done + 1 (disparado pelo encadeamento);
+    // este fica armado, sem disparar, para o bloco done + 2
+    dma_channel_set_write_addr(ch, sample_ring_block(&active->ring, done + 2), false);
+    sample_ring_commit(&active->ring);
+    active->block_time_us = time_us_32();
+  }
+}
+
+static void joystick_config_channel(uint ch, uint chain_to, joystick_sample_t *block) {
+  dma_channel_config c = dma_channel_get_default_config(ch);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, false);
+  channel_config_set_write_increment(&c, true);
+  channel_config_set_dreq(&c, DREQ_ADC);
+  channel_config_set_chain_to(&c, chain_to);
+  dma_channel_configure(ch, &c, block, &adc_hw->fifo, SAMPLE_RING_BLOCK_SAMPLES * 2, false);
+  dma_channel_set_irq1_enabled(ch, true);
+}
+
+void joystick_init(joystick_t *js, uint32_t sample_rate) {
+  sample_ring_init(&js->ring);
+  js->sample_rate = sample_rate;
+  js->dma_a = dma_claim_unused_channel(true);
+  js->dma_b = dma_claim_unused_channel(true);
+  active = js;
+
+  // Cada par sao duas conversoes; o divisor conta ciclos do clk_adc (48 MHz)
+  // entre conversoes, com minimo de 96 ciclos (500 kS/s)
+  float div = (float)clock_get_hz(clk_adc) / (2.0f * sample_rate) - 1.0f;
+  adc_set_clkdiv(div < 96.0f ? 0.0f : div);
+  // FIFO com DREQ a cada amostra, sem bit de erro e sem reduzir para 8 bits
+  adc_fifo_setup(true, true, 1, false, false);
+
+  irq_add_shared_handler(DMA_IRQ_1, joystick_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+  irq_set_enabled(DMA_IRQ_1, true);
+}
+
+void joystick_start(joystick_t *js) {
+  adc_run(false);
+  adc_fifo_drain();
+  sample_ring_init(&js->ring);
+
+  // O round-robin precisa comecar no ADC0 para que cada par seja {x, y}
+  adc_select_input(0);
+  adc_set_round_robin(0b11);
+
+  joystick_config_channel(js->dma_a, js->dma_b, sample_ring_block(&js->ring, 0));
+  joystick_config_channel(js->dma_b, js->dma_a, sample_ring_block(&js->ring, 1));
+  dma_channel_start(js->dma_a);
+  adc_run(true);
+}
+
+void joystick_stop(joystick_t *js) {
+  adc_run(false);
+  dma_channel_set_irq1_enabled(js->dma_a, false);
+  dma_channel_set_irq1_enabled(js->dma_b, false);
+  dma_channel_abort(js->dma_a);
+  dma_channel_abort(js->dma_b);
+  adc_set_round_robin(0);
+  adc_fifo_drain();
+}
@@ -0,0 +1,28 @@
+#ifndef JOYSTICK_H
+#define JOYSTICK_H
+
+#include "hal.h"
+#include "sample_ring.h"
+
+// Captura continua dos dois eixos: o ADC alterna ADC0/ADC1 (round-robin) e
+// dois canais de DMA encadeados esvaziam a FIFO em blocos alternados do anel
+typedef struct {
+  sample_ring_t ring;
+  uint dma_a, dma_b;
+  uint32_t sample_rate;   // Pares X/Y por segundo
+  volatile uint32_t block_time_us;  // time_us_32() ao completar o ultimo bloco
+} joystick_t;
+
+void joystick_init(joystick_t *js, uint32_t sample_rate);
+void joystick_start(joystick_t *js);
+void joystick_stop(joystick_t *js);
+
+static inline bool joystick_latest(joystick_t *js, joystick_sample_t *out) {
+  return sample_ring_latest(&js->ring, out);
+}
+
+static inline size_t joystick_read(joystick_t *js, joystick_sample_t *out, size_t max) {
+  return sample_ring_read(&js->ring, out, max);
+}
+
+#endif
@@ -0,0 +1,35 @@
+#include "hal.h"
+#include "joystick.h"
+
+// Fonte sintetica para o host: um timer com o periodo de um bloco preenche
+// o anel com as leituras atuais de hal_adc_read, no lugar do DMA
+static hal_timer_t joystick_timer;
+
+static bool joystick_block(void *user) {
+  joystick_t *js = user;
+  joystick_sample_t *block = sample_ring_block(&js->ring, js->ring.written);
+  for (int i = 0; i < SAMPLE_RING_BLOCK_SAMPLES; ++i) {
+    block[i].x = hal_adc_read(0);
+    block[i].y = hal_adc_read(1);
+  }
+  sample_ring_commit(&js->ring);
+  js->block_time_us = hal_time_us();
+  return true;
+}
+
+void joystick_init(joystick_t *js, uint32_t sample_rate) {
+  sample_ring_init(&js->ring);
+  js->sample_rate = sample_rate;
+  js->dma_a = js->dma_b = 0;
+  js->block_time_us = 0;
+}
+
+void joystick_start(joystick_t *js) {
+  sample_ring_init(&js->ring);
+  hal_timer_start(&joystick_timer, SAMPLE_RING_BLOCK_SAMPLES * 1000000u / js->sample_rate, joystick_block, js);
+}
+
+void joystick_stop(joystick_t *js) {
+  (void)js;
+  hal_timer_stop(&joystick_timer);
+}
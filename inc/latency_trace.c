@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <string.h>
+#include "latency_trace.h"
+
+#if LATENCY_TRACE
+
+static const char *const trace_stage_names[TRACE_STAGES] = {
+  "adc", "map", "pwm", "render", "i2c_start", "i2c_end",
+};
+
+void latency_trace_reset(latency_trace_t *trace) {
+  memset(trace, 0, sizeof(*trace));
+}
+
+static void trace_histogram_add(trace_histogram_t *h, uint32_t us) {
+  uint32_t bin = us / TRACE_BIN_US;
+  h->bins[bin < TRACE_BINS ? bin : TRACE_BINS - 1]++;
+  if (!h->count || us < h->min)
+    h->min = us;
+  if (us > h->max)
+    h->max = us;
+  h->sum += us;
+  h->count++;
+}
+
+void latency_trace_commit(latency_trace_t *trace, const trace_record_t *record) {
+  uint32_t origin = record->t[TRACE_ADC];
+  if (!origin)
+    return;
+  for (int i = TRACE_ADC + 1; i < TRACE_STAGES; ++i)
+    if (record->t[i])
+      trace_histogram_add(&trace->stage[i], record->t[i] - origin);
+}
+
+// Limite superior do bin que contem o percentil 99
+static uint32_t trace_histogram_p99(const trace_histogram_t *h) {
+  uint32_t target = h->count - h->count / 100;
+  uint32_t seen = 0;
+  for (int i = 0; i < TRACE_BINS - 1; ++i) {
+    seen += h->bins[i];
+    if (seen >= target)
+      return (i + 1) * TRACE_BIN_US;
+  }
+  return h->max;
+}
+
+void latency_trace_dump(const latency_trace_t *trace) {
+  printf("stage      count    min   mean    p99    max (us desde adc)\n");
+  for (int i = TRACE_ADC + 1; i < TRACE_STAGES; ++i) {
+    const trace_histogram_t *h = &trace->stage[i];
+    if (!h->count) {
+      printf("%-9s %6u\n", trace_stage_names[i], 0u);
+      continue;
+    }
+    printf("%-9s %6lu %6lu %6lu %6lu %6lu\n", trace_stage_names[i],
+           (unsigned long)h->count, (unsigned long)h->min,
+           (unsigned long)(h->sum / h->count), (unsigned long)trace_histogram_p99(h),
+           (unsigned long)h->max);
+  }
+}
+
+#endif
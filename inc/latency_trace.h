@@ -0,0 +1,70 @@
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <stdint.h>
+#include "hal.h"
+
+// Rastreamento ligado por padrao e removido em builds de release (NDEBUG),
+// a menos que LATENCY_TRACE seja definido explicitamente
+#ifndef LATENCY_TRACE
+#ifdef NDEBUG
+#define LATENCY_TRACE 0
+#else
+#define LATENCY_TRACE 1
+#endif
+#endif
+
+// Etapas do caminho entrada -> LEDs/display, na ordem em que ocorrem
+typedef enum {
+  TRACE_ADC,        // Bloco de amostras completo (IRQ do DMA do ADC)
+  TRACE_MAP,        // Calibracao e mapeamento feitos
+  TRACE_PWM,        // Niveis de PWM escritos
+  TRACE_RENDER,     // Quadro desenhado no framebuffer
+  TRACE_I2C_START,  // Transferencia do quadro iniciada
+  TRACE_I2C_END,    // Transferencia concluida (STOP no barramento)
+  TRACE_STAGES
+} trace_stage_t;
+
+// Instantes (hal_time_us) de cada etapa de um quadro
+typedef struct {
+  uint32_t t[TRACE_STAGES];
+} trace_record_t;
+
+// Histograma de latencias em relacao a TRACE_ADC; o ultimo bin acumula
+// tudo acima de (TRACE_BINS - 1) * TRACE_BIN_US
+#define TRACE_BIN_US 256
+#define TRACE_BINS 128
+
+typedef struct {
+  uint32_t count, min, max;
+  uint64_t sum;
+  uint32_t bins[TRACE_BINS];
+} trace_histogram_t;
+
+typedef struct {
+  trace_histogram_t stage[TRACE_STAGES];
+} latency_trace_t;
+
+#if LATENCY_TRACE
+
+// Custo por etapa: uma leitura do timer e um store
+#define TRACE_STAMP(record, stage) ((record)->t[(stage)] = hal_time_us())
+#define TRACE_SET(record, stage, time) ((record)->t[(stage)] = (time))
+
+void latency_trace_reset(latency_trace_t *trace);
+// Acumula um quadro completo; etapas com instante 0 sao ignoradas
+void latency_trace_commit(latency_trace_t *trace, const trace_record_t *record);
+// Imprime contagem, minimo, media, p99 e maximo de cada etapa (stdio)
+void latency_trace_dump(const latency_trace_t *trace);
+
+#else
+
+#define TRACE_STAMP(record, stage) ((void)0)
+#define TRACE_SET(record, stage, time) ((void)0)
+#define latency_trace_reset(trace) ((void)0)
+#define latency_trace_commit(trace, record) ((void)0)
+#define latency_trace_dump(trace) ((void)0)
+
+#endif
+
+#endif
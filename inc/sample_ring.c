@@ -0,0 +1,51 @@
+#include <stdatomic.h>
+#include <string.h>
+#include "sample_ring.h"
+
+// Blocos completos que o consumidor ainda pode ler com seguranca
+#define SAMPLE_RING_READABLE (SAMPLE_RING_BLOCKS - 2)
+
+void sample_ring_init(sample_ring_t *ring) {
+  memset(ring, 0, sizeof(*ring));
+}
+
+// Copia ate max amostras dos blocos completos ainda nao lidos, em ordem.
+// Se o produtor estiver mais de SAMPLE_RING_READABLE blocos a frente, os
+// blocos mais antigos sao descartados e contados em overruns.
+size_t sample_ring_read(sample_ring_t *ring, joystick_sample_t *out, size_t max) {
+  size_t count = 0;
+  while (count + SAMPLE_RING_BLOCK_SAMPLES <= max) {
+    uint32_t written = ring->written;
+    if (ring->read == written)
+      break;
+    if (written - ring->read > SAMPLE_RING_READABLE) {
+      ring->overruns += written - SAMPLE_RING_READABLE - ring->read;
+      ring->read = written - SAMPLE_RING_READABLE;
+    }
+
+    // A copia nao e volatile: as barreiras a mantem entre as duas leituras de
+    // written, sem o compilador adiantar ou atrasar os acessos ao bloco
+    atomic_signal_fence(memory_order_seq_cst);
+    memcpy(&out[count], sample_ring_block(ring, ring->read), sizeof(ring->samples[0]));
+    atomic_signal_fence(memory_order_seq_cst);
+
+    // O produtor pode ter alcancado o bloco durante a copia: descarta-o
+    if (ring->written - ring->read > SAMPLE_RING_READABLE + 1) {
+      ring->overruns++;
+      ring->read++;
+      continue;
+    }
+    ring->read++;
+    count += SAMPLE_RING_BLOCK_SAMPLES;
+  }
+  return count;
+}
+
+// Amostra mais recente do ultimo bloco completo; false antes do primeiro bloco
+bool sample_ring_latest(const sample_ring_t *ring, joystick_sample_t *out) {
+  uint32_t written = ring->written;
+  if (!written)
+    return false;
+  *out = ring->samples[(written - 1) % SAMPLE_RING_BLOCKS][SAMPLE_RING_BLOCK_SAMPLES - 1];
+  return true;
+}
@@ -0,0 +1,43 @@
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Blocos do anel e amostras (pares X/Y) por bloco
+#define SAMPLE_RING_BLOCKS 16
+#define SAMPLE_RING_BLOCK_SAMPLES 32
+
+// Uma conversao de cada eixo; a ordem casa com o round-robin ADC0, ADC1
+typedef struct {
+  uint16_t x, y;
+} joystick_sample_t;
+
+// Anel de blocos preenchido por um produtor (DMA ou fonte sintetica) e lido
+// pelo laco principal. O produtor escreve o bloco `written` e mantem o
+// seguinte armado; por isso o consumidor so acessa os ultimos
+// SAMPLE_RING_BLOCKS - 2 blocos completos.
+typedef struct {
+  joystick_sample_t samples[SAMPLE_RING_BLOCKS][SAMPLE_RING_BLOCK_SAMPLES];
+  volatile uint32_t written;  // Blocos completos (somente o produtor altera)
+  uint32_t read;              // Proximo bloco a ser lido pelo consumidor
+  uint32_t overruns;          // Blocos perdidos por leitura atrasada
+} sample_ring_t;
+
+void sample_ring_init(sample_ring_t *ring);
+
+// Produtor: bloco de numero n (modulo o tamanho do anel)
+static inline joystick_sample_t *sample_ring_block(sample_ring_t *ring, uint32_t n) {
+  return ring->samples[n % SAMPLE_RING_BLOCKS];
+}
+
+// Produtor: marca o bloco atual como completo (chamado da IRQ do DMA)
+static inline void sample_ring_commit(sample_ring_t *ring) {
+  ring->written = ring->written + 1;
+}
+
+size_t sample_ring_read(sample_ring_t *ring, joystick_sample_t *out, size_t max);
+bool sample_ring_latest(const sample_ring_t *ring, joystick_sample_t *out);
+
+#endif
@@ -0,0 +1,73 @@
+#include <string.h>
+#include "scheduler.h"
+
+void scheduler_init(scheduler_t *s, uint32_t tick_us, scheduler_clock_t now_us) {
+  memset(s, 0, sizeof(*s));
+  s->tick_us = tick_us;
+  s->now_us = now_us;
+}
+
+scheduler_task_t *scheduler_add(scheduler_t *s, scheduler_fn_t fn, void *user, uint32_t period, uint32_t phase) {
+  if (s->count == SCHEDULER_MAX_TASKS || !period)
+    return NULL;
+  scheduler_task_t *t = &s->tasks[s->count++];
+  memset(t, 0, sizeof(*t));
+  t->fn = fn;
+  t->user = user;
+  t->period = period;
+  t->next = s->done + 1 + phase;
+  return t;
+}
+
+void scheduler_reset_stats(scheduler_t *s) {
+  s->late_ticks = 0;
+  for (uint8_t i = 0; i < s->count; ++i) {
+    scheduler_task_t *t = &s->tasks[i];
+    t->runs = t->overruns = t->jitter_max = t->duration_max = 0;
+    t->jitter_sum = 0;
+  }
+}
+
+void scheduler_begin(scheduler_t *s) {
+  s->start_us = s->now_us();
+  s->ticks = s->done;
+  // Ticks contados a partir daqui: o tick n e devido em start_us + (n - done) * tick_us
+  s->start_us -= s->done * s->tick_us;
+}
+
+bool scheduler_poll(scheduler_t *s) {
+  uint32_t tick = s->ticks;
+  if (tick == s->done)
+    return false;
+  // Com atraso de varios ticks so o mais recente e processado: cada tarefa
+  // roda no maximo uma vez e as execucoes puladas contam como overrun
+  s->late_ticks += tick - s->done - 1;
+  s->done = tick;
+
+  uint32_t ideal = s->start_us + tick * s->tick_us;
+  for (uint8_t i = 0; i < s->count; ++i) {
+    scheduler_task_t *t = &s->tasks[i];
+    int32_t behind = (int32_t)(tick - t->next);
+    if (behind < 0)
+      continue;
+    if (behind >= (int32_t)t->period) {
+      uint32_t missed = behind / t->period;
+      t->overruns += missed;
+      t->next += missed * t->period;
+    }
+    t->next += t->period;
+
+    uint32_t start = s->now_us();
+    uint32_t jitter = start - ideal;
+    t->fn(t->user);
+    uint32_t duration = s->now_us() - start;
+
+    t->runs++;
+    t->jitter_sum += jitter;
+    if (jitter > t->jitter_max)
+      t->jitter_max = jitter;
+    if (duration > t->duration_max)
+      t->duration_max = duration;
+  }
+  return true;
+}
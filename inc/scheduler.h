@@ -0,0 +1,61 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SCHEDULER_MAX_TASKS 8
+
+typedef void (*scheduler_fn_t)(void *user);
+typedef uint32_t (*scheduler_clock_t)(void);
+
+// Tarefa periodica, executada no contexto do laco principal
+typedef struct {
+  scheduler_fn_t fn;
+  void *user;
+  uint32_t period;        // Periodo em ticks
+  uint32_t next;          // Proximo tick em que a tarefa e devida
+  uint32_t runs;
+  uint32_t overruns;      // Execucoes perdidas por atraso do laco
+  uint32_t jitter_max;    // Atraso do inicio em relacao ao instante ideal (us)
+  uint64_t jitter_sum;
+  uint32_t duration_max;  // Tempo de execucao (us)
+} scheduler_task_t;
+
+// Escalonador com tick fixo. O tick vem de um timer (scheduler_signal na
+// IRQ) e as tarefas rodam em scheduler_poll, fora da interrupcao. O relogio
+// e injetado para o host poder usar um relogio virtual.
+typedef struct {
+  uint32_t tick_us;
+  uint32_t start_us;        // Instante ideal do tick 0
+  volatile uint32_t ticks;  // Ticks sinalizados pelo timer
+  uint32_t done;            // Ultimo tick processado
+  uint32_t late_ticks;      // Ticks em que o laco nao chegou a rodar
+  scheduler_clock_t now_us;
+  scheduler_task_t tasks[SCHEDULER_MAX_TASKS];
+  uint8_t count;
+} scheduler_t;
+
+void scheduler_init(scheduler_t *s, uint32_t tick_us, scheduler_clock_t now_us);
+// phase desloca a primeira execucao, para espalhar tarefas de mesmo periodo
+scheduler_task_t *scheduler_add(scheduler_t *s, scheduler_fn_t fn, void *user, uint32_t period, uint32_t phase);
+void scheduler_reset_stats(scheduler_t *s);
+
+// Marca o inicio da contagem (tick 0 = agora)
+void scheduler_begin(scheduler_t *s);
+
+// Chamado a cada tick pela fonte de tempo (IRQ do timer ou relogio virtual)
+static inline void scheduler_signal(scheduler_t *s) {
+  s->ticks = s->ticks + 1;
+}
+
+// Executa as tarefas devidas ate o ultimo tick sinalizado; false se nao havia tick novo
+bool scheduler_poll(scheduler_t *s);
+
+// Fonte de tempo pela HAL (scheduler_timer.c): timer periodico e espera
+// pela proxima interrupcao ate o proximo tick
+bool scheduler_start(scheduler_t *s);
+void scheduler_stop(scheduler_t *s);
+void scheduler_wait(scheduler_t *s);
+
+#endif
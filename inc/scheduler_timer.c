@@ -0,0 +1,27 @@
+#include "hal.h"
+#include "scheduler.h"
+
+static hal_timer_t scheduler_timer;
+
+static bool scheduler_timer_callback(void *user) {
+  scheduler_signal((scheduler_t *)user);
+  return true;
+}
+
+bool scheduler_start(scheduler_t *s) {
+  if (!s->now_us)
+    s->now_us = hal_time_us;
+  scheduler_begin(s);
+  return hal_timer_start(&scheduler_timer, s->tick_us, scheduler_timer_callback, s);
+}
+
+void scheduler_stop(scheduler_t *s) {
+  (void)s;
+  hal_timer_stop(&scheduler_timer);
+}
+
+// A IRQ do timer acorda o nucleo da espera
+void scheduler_wait(scheduler_t *s) {
+  while (s->ticks == s->done)
+    hal_wait_event();
+}
@@ -1,49 +1,113 @@
+#include <string.h>
 #include "ssd1306.h"
-#include "font.h"
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+// Janela suja vazia: dirty_x0 > dirty_x1
+static inline void ssd1306_clear_dirty(ssd1306_t *ssd) {
+  ssd->dirty_x0 = 0xFF;
+  ssd->dirty_x1 = 0;
+  ssd->dirty_page0 = 0xFF;
+  ssd->dirty_page1 = 0;
+}
+
+// Expande a janela suja para conter o retangulo (x0, y0)-(x1, y1), ja
+// ordenado e recortado a tela
+static inline void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+  if (x0 < ssd->dirty_x0) ssd->dirty_x0 = x0;
+  if (x1 > ssd->dirty_x1) ssd->dirty_x1 = x1;
+  if ((y0 >> 3) < ssd->dirty_page0) ssd->dirty_page0 = y0 >> 3;
+  if ((y1 >> 3) > ssd->dirty_page1) ssd->dirty_page1 = y1 >> 3;
+}
+
+// Recorta o retangulo (x0, y0)-(x1, y1) a area de recorte; false se ficar vazio
+static inline bool ssd1306_clip_box(const ssd1306_t *ssd, int16_t *x0, int16_t *y0, int16_t *x1, int16_t *y1) {
+  if (*x0 < ssd->clip_x0) *x0 = ssd->clip_x0;
+  if (*y0 < ssd->clip_y0) *y0 = ssd->clip_y0;
+  if (*x1 > ssd->clip_x1) *x1 = ssd->clip_x1;
+  if (*y1 > ssd->clip_y1) *y1 = ssd->clip_y1;
+  return *x0 <= *x1 && *y0 <= *y1;
+}
+
+// Borda final de um trecho que comeca em start com size > 0 pixels, calculada
+// em 32 bits e limitada a uma posicao depois de limit: cabe em int16_t e
+// continua fora da area de recorte quando o trecho passa dela
+static inline int16_t ssd1306_far_edge(int16_t start, int16_t size, int16_t limit) {
+  int32_t edge = (int32_t)start + size - 1;
+  return edge > limit ? limit + 1 : edge;
+}
+
+static inline void ssd1306_pixel_raw(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  uint16_t index = (y >> 3) + (x << 3) + 1;
+  uint8_t pixel = (y & 0b111);
+  if (value)
+    ssd->ram_buffer[index] |= (1 << pixel);
+  else
+    ssd->ram_buffer[index] &= ~(1 << pixel);
+}
+
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, hal_i2c_t *i2c) {
   ssd->width = width;
   ssd->height = height;
   ssd->pages = height / 8U;
   ssd->address = address;
   ssd->i2c_port = i2c;
   ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  // Desloca o buffer para que os dados (ram_buffer[1]) fiquem alinhados a 4
+  // bytes, permitindo comparacoes e escritas por palavra de 32 bits
+  ssd->ram_buffer = (uint8_t *)calloc(ssd->bufsize + 3, sizeof(uint8_t)) + 3;
   ssd->ram_buffer[0] = 0x40;
+  ssd->shadow_buffer = calloc(ssd->bufsize - 1, sizeof(uint8_t));
+  ssd->shadow_valid = false;
+  ssd->tx_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  ssd->tx_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+  ssd->async_backend = NULL;
+  ssd->async_buffer = NULL;
+  ssd->async_len = ssd->async_capacity = 0;
+  ssd->async_busy = false;
+  ssd->async_callback = NULL;
+  ssd->async_user = NULL;
+  ssd1306_reset_clip(ssd);
+  ssd1306_clear_dirty(ssd);
+}
+
+// Restringe todo o desenho ao retangulo (x0, y0)-(x1, y1), inclusive
+void ssd1306_set_clip(ssd1306_t *ssd, int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  ssd->clip_x0 = x0 < 0 ? 0 : x0;
+  ssd->clip_y0 = y0 < 0 ? 0 : y0;
+  ssd->clip_x1 = x1 >= ssd->width ? ssd->width - 1 : x1;
+  ssd->clip_y1 = y1 >= ssd->height ? ssd->height - 1 : y1;
+}
+
+void ssd1306_reset_clip(ssd1306_t *ssd) {
+  ssd1306_set_clip(ssd, 0, 0, ssd->width - 1, ssd->height - 1);
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  static const uint8_t config[] = {
+    SET_DISP | 0x00,
+    SET_MEM_ADDR, 0x01,
+    SET_DISP_START_LINE | 0x00,
+    SET_SEG_REMAP | 0x01,
+    SET_MUX_RATIO, HEIGHT - 1,
+    SET_COM_OUT_DIR | 0x08,
+    SET_DISP_OFFSET, 0x00,
+    SET_COM_PIN_CFG, 0x12,
+    SET_DISP_CLK_DIV, 0x80,
+    SET_PRECHARGE, 0xF1,
+    SET_VCOM_DESEL, 0x30,
+    SET_CONTRAST, 0xFF,
+    SET_ENTIRE_ON,
+    SET_NORM_INV,
+    SET_CHARGE_PUMP, 0x14,
+    SET_DISP | 0x01
+  };
+  ssd1306_command_list(ssd, config, sizeof(config));
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  ssd1306_wait(ssd);
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(
+  hal_i2c_write(
     ssd->i2c_port,
     ssd->address,
     ssd->port_buffer,
@@ -52,172 +116,532 @@ void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   );
 }
 
+// Envia varios comandos em uma unica transacao: byte de controle 0x00 (Co = 0)
+// seguido de todos os comandos, evitando START/endereco/STOP por comando
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+  uint8_t buffer[SSD1306_COMMAND_BATCH + 1];
+  buffer[0] = 0x00;
+  ssd1306_wait(ssd);
+  while (count) {
+    size_t n = count < SSD1306_COMMAND_BATCH ? count : SSD1306_COMMAND_BATCH;
+    memcpy(&buffer[1], commands, n);
+    hal_i2c_write(
+      ssd->i2c_port,
+      ssd->address,
+      buffer,
+      n + 1,
+      false
+    );
+    commands += n;
+    count -= n;
+  }
+}
+
+// Programa a janela de colunas x0..x1 e paginas p0..p1 em uma transacao
+static void ssd1306_set_window(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+  const uint8_t commands[] = { SET_COL_ADDR, x0, x1, SET_PAGE_ADDR, p0, p1 };
+  ssd1306_command_list(ssd, commands, sizeof(commands));
+}
+
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
+  ssd1306_set_window(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
+  hal_i2c_write(
     ssd->i2c_port,
     ssd->address,
     ssd->ram_buffer,
     ssd->bufsize,
     false
   );
+  memcpy(ssd->shadow_buffer, &ssd->ram_buffer[1], ssd->bufsize - 1);
+  ssd->shadow_valid = true;
+  ssd1306_clear_dirty(ssd);
 }
 
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
-  uint8_t pixel = (y & 0b111);
-  if (value)
-    ssd->ram_buffer[index] |= (1 << pixel);
-  else
-    ssd->ram_buffer[index] &= ~(1 << pixel);
+// Envia a janela de colunas x0..x1 e paginas p0..p1 e atualiza a copia do
+// ultimo quadro transmitido
+static void ssd1306_send_window(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+  uint8_t npages = p1 - p0 + 1;
+
+  // Modo de enderecamento vertical: cada coluna envia as paginas p0..p1
+  size_t len = 1;
+  for (uint8_t x = x0; x <= x1; ++x) {
+    const uint8_t *col = &ssd->ram_buffer[1 + (x << 3) + p0];
+    uint8_t *shadow = &ssd->shadow_buffer[(x << 3) + p0];
+    for (uint8_t p = 0; p < npages; ++p) {
+      ssd->tx_buffer[len++] = col[p];
+      shadow[p] = col[p];
+    }
+  }
+
+  ssd1306_set_window(ssd, x0, x1, p0, p1);
+  hal_i2c_write(
+    ssd->i2c_port,
+    ssd->address,
+    ssd->tx_buffer,
+    len,
+    false
+  );
 }
 
-/*
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
+// Envia apenas a janela (colunas x paginas) alterada desde o ultimo envio
+void ssd1306_send_dirty(ssd1306_t *ssd) {
+  if (ssd->dirty_x0 > ssd->dirty_x1)
+    return;
+  ssd1306_send_window(ssd, ssd->dirty_x0, ssd->dirty_x1, ssd->dirty_page0, ssd->dirty_page1);
+  ssd1306_clear_dirty(ssd);
+}
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
+// Mascara das paginas (bit p = pagina p) que diferem em uma coluna de 8 bytes
+static inline uint8_t ssd1306_column_diff(const uint32_t *cur, const uint32_t *old) {
+  uint32_t lo = cur[0] ^ old[0];
+  uint32_t hi = cur[1] ^ old[1];
+  uint8_t mask = 0;
+  for (uint8_t p = 0; p < 4; ++p) {
+    if (lo & (0xFFu << (p * 8))) mask |= 1u << p;
+    if (hi & (0xFFu << (p * 8))) mask |= 1u << (p + 4);
+  }
+  return mask;
+}
+
+typedef void (*ssd1306_window_fn)(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1);
+
+// Compara o quadro atual com o ultimo transmitido e entrega a emit() apenas as
+// sequencias de colunas alteradas. Colunas iguais separadas por ate
+// SSD1306_DIFF_MERGE_GAP colunas sao agrupadas, pois reenviar alguns bytes
+// custa menos que reprogramar a janela de enderecamento.
+static void ssd1306_diff(ssd1306_t *ssd, ssd1306_window_fn emit) {
+  // ram_buffer[1] e shadow_buffer sao alinhados a 4 bytes (ver ssd1306_init)
+  const uint32_t *cur = (const uint32_t *)&ssd->ram_buffer[1];
+  const uint32_t *old = (const uint32_t *)ssd->shadow_buffer;
+  uint8_t x = 0;
+
+  while (x < ssd->width) {
+    uint8_t pages = ssd1306_column_diff(&cur[x * 2], &old[x * 2]);
+    if (!pages) {
+      ++x;
+      continue;
     }
+
+    uint8_t start = x, end = x;
+    for (++x; x < ssd->width && x <= end + SSD1306_DIFF_MERGE_GAP + 1; ++x) {
+      uint8_t diff = ssd1306_column_diff(&cur[x * 2], &old[x * 2]);
+      if (diff) {
+        pages |= diff;
+        end = x;
+      }
+    }
+    x = end + 1;
+
+    uint8_t p0 = 0, p1 = 7;
+    while (!(pages & (1u << p0))) ++p0;
+    while (!(pages & (1u << p1))) --p1;
+    emit(ssd, start, end, p0, p1);
+  }
+  ssd1306_clear_dirty(ssd);
 }
 
+void ssd1306_send_diff(ssd1306_t *ssd) {
+  if (!ssd->shadow_valid) {
+    ssd1306_send_data(ssd);
+    return;
+  }
+  ssd1306_diff(ssd, ssd1306_send_window);
+}
 
+// ======= Transferencia assincrona =======
 
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
+void ssd1306_set_async_backend(ssd1306_t *ssd, const ssd1306_async_backend_t *backend) {
+  ssd1306_wait(ssd);
+  ssd->async_backend = backend;
+  if (backend && !ssd->async_buffer) {
+    // Pior caso: quadro inteiro mais 8 palavras de enderecamento por janela do diff
+    ssd->async_capacity = (ssd->bufsize - 1) + 8 * (ssd->width / (SSD1306_DIFF_MERGE_GAP + 2) + 1);
+    ssd->async_buffer = calloc(ssd->async_capacity, sizeof(uint16_t));
   }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
+}
+
+void ssd1306_set_async_callback(ssd1306_t *ssd, ssd1306_async_callback_t callback, void *user) {
+  ssd->async_callback = callback;
+  ssd->async_user = user;
+}
+
+bool ssd1306_busy(ssd1306_t *ssd) {
+  if (!ssd->async_busy)
+    return false;
+  if (ssd->async_backend->busy(ssd->async_backend->ctx))
+    return true;
+  ssd->async_busy = false;
+  if (ssd->async_callback)
+    ssd->async_callback(ssd, ssd->async_user);
+  return false;
+}
+
+void ssd1306_wait(ssd1306_t *ssd) {
+  while (ssd1306_busy(ssd))
+    hal_idle();
+}
+
+// Acrescenta ao segundo quadro duas transacoes: os comandos de janela
+// (controle 0x00) e os dados (controle 0x40), separadas por RESTART
+static void ssd1306_queue_window(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+  uint16_t *w = &ssd->async_buffer[ssd->async_len];
+  uint8_t npages = p1 - p0 + 1;
+
+  *w++ = (ssd->async_len ? SSD1306_WORD_RESTART : 0) | 0x00;
+  *w++ = SET_COL_ADDR;
+  *w++ = x0;
+  *w++ = x1;
+  *w++ = SET_PAGE_ADDR;
+  *w++ = p0;
+  *w++ = p1;
+  *w++ = SSD1306_WORD_RESTART | 0x40;
+  for (uint8_t x = x0; x <= x1; ++x) {
+    const uint8_t *col = &ssd->ram_buffer[1 + (x << 3) + p0];
+    uint8_t *shadow = &ssd->shadow_buffer[(x << 3) + p0];
+    for (uint8_t p = 0; p < npages; ++p) {
+      *w++ = col[p];
+      shadow[p] = col[p];
+    }
   }
+  ssd->async_len = w - ssd->async_buffer;
+}
+
+static void ssd1306_start_async(ssd1306_t *ssd) {
+  if (!ssd->async_len)
+    return;
+  ssd->async_buffer[ssd->async_len - 1] |= SSD1306_WORD_STOP;
+  ssd->async_busy = true;
+  ssd->async_backend->start(ssd->async_backend->ctx, ssd->address, ssd->async_buffer, ssd->async_len);
+}
 
+// Copia o quadro para o segundo buffer e inicia o envio sem bloquear;
+// ram_buffer pode ser redesenhado imediatamente
+void ssd1306_send_data_async(ssd1306_t *ssd) {
+  if (!ssd->async_backend) {
+    ssd1306_send_data(ssd);
+    return;
+  }
+  ssd1306_wait(ssd);
+  ssd->async_len = 0;
+  ssd1306_queue_window(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
+  ssd->shadow_valid = true;
+  ssd1306_clear_dirty(ssd);
+  ssd1306_start_async(ssd);
+}
+
+void ssd1306_send_diff_async(ssd1306_t *ssd) {
+  if (!ssd->async_backend) {
+    ssd1306_send_diff(ssd);
+    return;
+  }
+  if (!ssd->shadow_valid) {
+    ssd1306_send_data_async(ssd);
+    return;
+  }
+  ssd1306_wait(ssd);
+  ssd->async_len = 0;
+  ssd1306_diff(ssd, ssd1306_queue_window);
+  ssd1306_start_async(ssd);
+}
+
+void ssd1306_pixel(ssd1306_t *ssd, int16_t x, int16_t y, bool value) {
+  if (x < ssd->clip_x0 || x > ssd->clip_x1 || y < ssd->clip_y0 || y > ssd->clip_y1)
+    return;
+  ssd1306_mark_dirty(ssd, x, y, x, y);
+  ssd1306_pixel_raw(ssd, x, y, value);
+}
+
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  ssd1306_mark_dirty(ssd, 0, 0, ssd->width - 1, ssd->height - 1);
+  // ram_buffer[0] e o byte de controle 0x40; os dados vem logo em seguida
+  memset(&ssd->ram_buffer[1], value ? 0xFF : 0x00, ssd->bufsize - 1);
+}
+
+// Preenche um retangulo escrevendo bytes inteiros nas paginas internas e
+// aplicando mascara apenas nas paginas parciais do topo e da base
+void ssd1306_fill_rect(ssd1306_t *ssd, int16_t top, int16_t left, int16_t width, int16_t height, bool value) {
+  if (width <= 0 || height <= 0)
+    return;
+  int16_t right = ssd1306_far_edge(left, width, ssd->clip_x1);
+  int16_t bottom = ssd1306_far_edge(top, height, ssd->clip_y1);
+  if (!ssd1306_clip_box(ssd, &left, &top, &right, &bottom))
+    return;
+  ssd1306_mark_dirty(ssd, left, top, right, bottom);
+
+  uint8_t p0 = top >> 3, p1 = bottom >> 3;
+  uint8_t mask0 = 0xFF << (top & 7);
+  uint8_t mask1 = 0xFF >> (7 - (bottom & 7));
+  if (p0 == p1)
+    mask0 = mask1 = mask0 & mask1;
+
+  for (int16_t x = left; x <= right; ++x) {
+    uint8_t *col = &ssd->ram_buffer[1 + (x << 3)];
+    if (value) {
+      col[p0] |= mask0;
+      for (uint8_t p = p0 + 1; p < p1; ++p)
+        col[p] = 0xFF;
+      col[p1] |= mask1;
+    } else {
+      col[p0] &= ~mask0;
+      for (uint8_t p = p0 + 1; p < p1; ++p)
+        col[p] = 0x00;
+      col[p1] &= ~mask1;
+    }
+  }
+}
+
+// Contorno com duas hlines e duas vlines; preenchimento via ssd1306_fill_rect
+void ssd1306_rect(ssd1306_t *ssd, int16_t top, int16_t left, int16_t width, int16_t height, bool value, bool fill) {
+  if (width <= 0 || height <= 0)
+    return;
   if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
+    ssd1306_fill_rect(ssd, top, left, width, height, value);
+    return;
+  }
+  int16_t right = ssd1306_far_edge(left, width, ssd->clip_x1);
+  int16_t bottom = ssd1306_far_edge(top, height, ssd->clip_y1);
+  ssd1306_hline(ssd, left, right, top, value);
+  ssd1306_hline(ssd, left, right, bottom, value);
+  ssd1306_vline(ssd, left, top, bottom, value);
+  ssd1306_vline(ssd, right, top, bottom, value);
+}
+
+// Codigos de regiao de Cohen-Sutherland
+#define CLIP_LEFT   1
+#define CLIP_RIGHT  2
+#define CLIP_TOP    4
+#define CLIP_BOTTOM 8
+
+static inline uint8_t ssd1306_outcode(const ssd1306_t *ssd, int32_t x, int32_t y) {
+  uint8_t code = 0;
+  if (x < ssd->clip_x0) code |= CLIP_LEFT;
+  else if (x > ssd->clip_x1) code |= CLIP_RIGHT;
+  if (y < ssd->clip_y0) code |= CLIP_TOP;
+  else if (y > ssd->clip_y1) code |= CLIP_BOTTOM;
+  return code;
+}
+
+// Recorta o segmento a area de recorte (Cohen-Sutherland); false se ficar fora
+static bool ssd1306_clip_line(const ssd1306_t *ssd, int32_t *x0, int32_t *y0, int32_t *x1, int32_t *y1) {
+  uint8_t code0 = ssd1306_outcode(ssd, *x0, *y0);
+  uint8_t code1 = ssd1306_outcode(ssd, *x1, *y1);
+
+  while (code0 | code1) {
+    if (code0 & code1)
+      return false;
+
+    uint8_t code = code0 ? code0 : code1;
+    int32_t dx = *x1 - *x0, dy = *y1 - *y0;
+    int32_t x, y;
+    if (code & CLIP_TOP) {
+      y = ssd->clip_y0;
+      x = *x0 + (int32_t)((int64_t)dx * (y - *y0) / dy);
+    } else if (code & CLIP_BOTTOM) {
+      y = ssd->clip_y1;
+      x = *x0 + (int32_t)((int64_t)dx * (y - *y0) / dy);
+    } else if (code & CLIP_LEFT) {
+      x = ssd->clip_x0;
+      y = *y0 + (int32_t)((int64_t)dy * (x - *x0) / dx);
+    } else {
+      x = ssd->clip_x1;
+      y = *y0 + (int32_t)((int64_t)dy * (x - *x0) / dx);
+    }
+
+    if (code == code0) {
+      *x0 = x; *y0 = y;
+      code0 = ssd1306_outcode(ssd, x, y);
+    } else {
+      *x1 = x; *y1 = y;
+      code1 = ssd1306_outcode(ssd, x, y);
     }
   }
+  return true;
 }
 
-void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
-    int dx = abs(x1 - x0);
-    int dy = abs(y1 - y0);
+void ssd1306_line(ssd1306_t *ssd, int16_t x0, int16_t y0, int16_t x1, int16_t y1, bool value) {
+    int32_t cx0 = x0, cy0 = y0, cx1 = x1, cy1 = y1;
+    // Recorta uma unica vez; dentro da area o Bresenham nao testa limites
+    if (!ssd1306_clip_line(ssd, &cx0, &cy0, &cx1, &cy1))
+        return;
 
-    int sx = (x0 < x1) ? 1 : -1;
-    int sy = (y0 < y1) ? 1 : -1;
+    int dx = abs(cx1 - cx0);
+    int dy = abs(cy1 - cy0);
+
+    int sx = (cx0 < cx1) ? 1 : -1;
+    int sy = (cy0 < cy1) ? 1 : -1;
 
     int err = dx - dy;
 
+    ssd1306_mark_dirty(ssd, cx0 < cx1 ? cx0 : cx1, cy0 < cy1 ? cy0 : cy1,
+                       cx0 < cx1 ? cx1 : cx0, cy0 < cy1 ? cy1 : cy0);
+
     while (true) {
-        ssd1306_pixel(ssd, x0, y0, value); // Desenha o pixel atual
+        ssd1306_pixel_raw(ssd, cx0, cy0, value); // Desenha o pixel atual
 
-        if (x0 == x1 && y0 == y1) break; // Termina quando alcança o ponto final
+        if (cx0 == cx1 && cy0 == cy1) break; // Termina quando alcança o ponto final
 
         int e2 = err * 2;
 
         if (e2 > -dy) {
             err -= dy;
-            x0 += sx;
+            cx0 += sx;
         }
 
         if (e2 < dx) {
             err += dx;
-            y0 += sy;
+            cy0 += sy;
         }
     }
 }
 
 
-void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+// Uma linha horizontal altera o mesmo bit da mesma pagina em colunas
+// consecutivas, que ficam a 8 bytes de distancia no buffer
+void ssd1306_hline(ssd1306_t *ssd, int16_t x0, int16_t x1, int16_t y, bool value) {
+  int16_t y1 = y;
+  if (x0 > x1 || !ssd1306_clip_box(ssd, &x0, &y, &x1, &y1))
+    return;
+  ssd1306_mark_dirty(ssd, x0, y, x1, y);
+
+  uint8_t *byte = &ssd->ram_buffer[1 + (x0 << 3) + (y >> 3)];
+  uint8_t *end = byte + ((x1 - x0) << 3);
+  uint8_t bit = 1u << (y & 7);
+  if (value) {
+    for (; byte <= end; byte += 8)
+      *byte |= bit;
+  } else {
+    for (; byte <= end; byte += 8)
+      *byte &= ~bit;
+  }
 }
 
-void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+// Uma linha vertical e um retangulo de uma coluna: cada pagina e escrita uma vez
+void ssd1306_vline(ssd1306_t *ssd, int16_t x, int16_t y0, int16_t y1, bool value) {
+  int16_t x1 = x;
+  if (y0 > y1 || !ssd1306_clip_box(ssd, &x, &y0, &x1, &y1))
+    return;
+  ssd1306_fill_rect(ssd, y0, x, 1, y1 - y0 + 1, value);
 }
 
-// Função para desenhar um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
-{
-  uint16_t index = 0;
-  char ver=c;
+// Recorta o bloco de paginas ao retangulo de recorte. Colunas e paginas
+// fora dele sao puladas (skip, page_skip); nas paginas que o retangulo corta
+// ao meio, mask guarda as linhas que podem ser copiadas. False se nada sobrar
+static bool ssd1306_clip_pages(const ssd1306_t *ssd, int16_t *x, uint8_t *page, uint8_t *width, uint8_t *pages,
+                               int16_t *skip, uint8_t *page_skip, uint8_t mask[8]) {
+  int16_t x0 = *x < ssd->clip_x0 ? ssd->clip_x0 : *x;
+  int16_t x1 = *x + *width - 1;
+  if (x1 > ssd->clip_x1)
+    x1 = ssd->clip_x1;
+  int16_t p0 = ssd->clip_y0 >> 3, p1 = ssd->clip_y1 >> 3;
+  int16_t first = *page > p0 ? *page : p0;
+  int16_t last = *page + *pages - 1 < p1 ? *page + *pages - 1 : p1;
+  if (x0 > x1 || first > last)
+    return false;
+  *skip = x0 - *x;
+  *page_skip = first - *page;
+  *x = x0;
+  *width = x1 - x0 + 1;
+  *page = first;
+  *pages = last - first + 1;
+  for (uint8_t p = 0; p < *pages; ++p)
+    mask[p] = 0xFF;
+  if (first == p0)
+    mask[0] &= 0xFF << (ssd->clip_y0 & 7);
+  if (last == p1)
+    mask[*pages - 1] &= 0xFF >> (7 - (ssd->clip_y1 & 7));
+  return true;
+}
 
-  if (c >= 'A' && c <= 'Z')
-  {
-    index = (c - 'A' + 11) * 8; // Para letras maiúsculas
+void ssd1306_read_pages(const ssd1306_t *ssd, int16_t x, uint8_t page, uint8_t width, uint8_t pages, uint8_t *dst) {
+  uint8_t stride = pages, page_skip, mask[8];
+  int16_t skip;
+  if (!ssd1306_clip_pages(ssd, &x, &page, &width, &pages, &skip, &page_skip, mask))
+    return;
+  dst += skip * stride + page_skip;
+  for (uint8_t i = 0; i < width; ++i, dst += stride) {
+    const uint8_t *col = &ssd->ram_buffer[1 + ((x + i) << 3) + page];
+    for (uint8_t p = 0; p < pages; ++p)
+      dst[p] = (dst[p] & ~mask[p]) | (col[p] & mask[p]);
   }
-  else  if (c >= '0' && c <= '9')
-  {
-    index = (c - '0' + 1) * 8; // Adiciona o deslocamento necessário
 }
-  else if (c == 'c')
-  {
-      index = 37 * 8; // Index for lowercase 'c'
-  }
-  else if (c == 'a')
-  {
-      index = 38 * 8; // Index for lowercase 'a'
-  }
-  else if (c == 'm')
-  {
-      index = 39 * 8; // Index for lowercase 'm'
-  }
-  else if (c == 'i')
-  {
-      index = 40 * 8; // Index for lowercase 'i'
+
+void ssd1306_write_pages(ssd1306_t *ssd, int16_t x, uint8_t page, uint8_t width, uint8_t pages, const uint8_t *src) {
+  uint8_t stride = pages, page_skip, mask[8];
+  int16_t skip;
+  if (!ssd1306_clip_pages(ssd, &x, &page, &width, &pages, &skip, &page_skip, mask))
+    return;
+  ssd1306_mark_dirty(ssd, x, page << 3, x + width - 1, ((page + pages) << 3) - 1);
+  src += skip * stride + page_skip;
+  // Poucas paginas por coluna: copia byte a byte, sem chamar memcpy
+  for (uint8_t i = 0; i < width; ++i, src += stride) {
+    uint8_t *col = &ssd->ram_buffer[1 + ((x + i) << 3) + page];
+    for (uint8_t p = 0; p < pages; ++p)
+      col[p] = (col[p] & ~mask[p]) | (src[p] & mask[p]);
   }
-  else if (c == 'l')
-  {
-      index = 41 * 8; // Index for lowercase 'l'
+}
+
+// Escreve uma coluna de 8 pixels (bit 0 no topo, em y) no buffer da coluna,
+// alterando apenas as linhas selecionadas em mask. Com y multiplo de 8 e a
+// celula inteira visivel e uma copia direta do byte; caso contrario sao duas
+// escritas deslocadas nas paginas vizinhas. Requer y >= -8.
+static inline void ssd1306_blit_column(uint8_t *col, int16_t y, uint8_t bits, uint8_t mask) {
+  uint8_t shift = (y + 8) & 7;
+  int16_t page = ((y + 8) >> 3) - 1;
+  if (!shift) {
+    if (mask == 0xFF)
+      col[page] = bits;
+    else
+      col[page] = (col[page] & ~mask) | (bits & mask);
+    return;
   }
+  uint16_t b = (uint16_t)(bits & mask) << shift;
+  uint16_t m = (uint16_t)mask << shift;
+  if (m & 0xFF)
+    col[page] = (col[page] & ~m) | b;
+  if (m >> 8)
+    col[page + 1] = (col[page + 1] & ~(m >> 8)) | (b >> 8);
+}
 
-  if (c == '!') {
-    // Desenha um "! gigante" (16x16 pixels)
-    for (uint8_t i = 0; i < 16; ++i) {
-        uint8_t line1 = big_exclamation_mark[i * 2];       // Parte alta do byte
-        uint8_t line2 = big_exclamation_mark[i * 2 + 1];   // Parte baixa do byte
-        for (uint8_t j = 0; j < 8; ++j) {
-            uint8_t pixel_on1 = (line1 >> (7 - j)) & 1;
-            uint8_t pixel_on2 = (line2 >> (7 - j)) & 1;
+// Desenha um glifo com a origem da linha em (x, y), uma faixa de 8 linhas por
+// vez atraves de ssd1306_blit_column. Opaco apaga os pixels apagados do
+// glifo; caso contrario so os pixels acesos sao escritos.
+static void ssd1306_draw_glyph(ssd1306_t *ssd, const font_t *font, const font_glyph_t *glyph, int16_t x, int16_t y, bool opaque)
+{
+  if (!glyph->width)
+    return;
+  int16_t gx = x + glyph->x_offset, gy = y + glyph->y_offset;
+  int16_t x0 = gx, y0 = gy, x1 = gx + glyph->width - 1, y1 = gy + glyph->height - 1;
+  if (!ssd1306_clip_box(ssd, &x0, &y0, &x1, &y1))
+    return;
+  ssd1306_mark_dirty(ssd, x0, y0, x1, y1);
 
-            // Desenha os dois blocos (duplicando horizontalmente para maior legibilidade)
-            ssd1306_pixel(ssd, x + j, y + i, pixel_on1);
-            ssd1306_pixel(ssd, x + j + 8, y + i, pixel_on2);
-        }
-    }
-    return; // Sai da função após desenhar o "! gigante"
-    
-  }  
-  
-  for (uint8_t i = 0; i < 8; ++i)
-  {
-    uint8_t line = font[index + i];
-    for (uint8_t j = 0; j < 8; ++j)
-    {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
+  uint8_t pages = (glyph->height + 7) >> 3;
+  for (uint8_t p = 0; p < pages; ++p) {
+    int16_t cy = gy + (p << 3);
+    int16_t above = y0 - cy, below = cy + 7 - y1;
+    if (above >= 8 || below >= 8)
+      continue;
+    uint8_t mask = 0xFF;
+    if (above > 0) mask &= 0xFF << above;
+    if (below > 0) mask &= 0xFF >> below;
+
+    const uint8_t *src = &font->bitmap[glyph->offset + (x0 - gx) * pages + p];
+    for (int16_t px = x0; px <= x1; ++px, src += pages) {
+      uint8_t write = opaque ? mask : (*src & mask);
+      if (write)
+        ssd1306_blit_column(&ssd->ram_buffer[1 + (px << 3)], cy, *src, write);
     }
   }
 }
 
+// Função para desenhar um caractere (fonte 8x8 original, celula opaca)
+void ssd1306_draw_char(ssd1306_t *ssd, char c, int16_t x, int16_t y)
+{
+  ssd1306_draw_glyph(ssd, &font_8x8, font_glyph(&font_8x8, c), x, y, true);
+}
+
 // Função para desenhar uma string
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, int16_t x, int16_t y)
 {
   while (*str)
   {
@@ -233,4 +657,38 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
       break;
     }
   }
-}
\ No newline at end of file
+}
+
+// Desenha um texto com a fonte informada a partir de (x, y), o topo da linha;
+// '\n' volta para x e desce uma linha. Retorna o x apos o ultimo caractere.
+int16_t ssd1306_draw_text(ssd1306_t *ssd, const font_t *font, const char *str, int16_t x, int16_t y)
+{
+  int16_t start = x;
+  for (; *str; ++str) {
+    if (*str == '\n') {
+      x = start;
+      y += font->line_height;
+      continue;
+    }
+    const font_glyph_t *glyph = font_glyph(font, *str);
+    ssd1306_draw_glyph(ssd, font, glyph, x, y, false);
+    x += glyph->advance;
+  }
+  return x;
+}
+
+// Largura em pixels da linha mais longa do texto
+uint16_t ssd1306_text_width(const font_t *font, const char *str)
+{
+  uint16_t width = 0, line = 0;
+  for (; *str; ++str) {
+    if (*str == '\n') {
+      line = 0;
+      continue;
+    }
+    line += font_glyph(font, *str)->advance;
+    if (line > width)
+      width = line;
+  }
+  return width;
+}
@@ -1,10 +1,24 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
-#include "pico/stdlib.h"
-#include "hardware/i2c.h"
+#include "hal.h"
+#include "fonts.h"
 
 #define WIDTH 128
 #define HEIGHT 64
 
+// Colunas inalteradas toleradas dentro de uma mesma janela em ssd1306_send_diff
+#define SSD1306_DIFF_MERGE_GAP 2
+
+// Comandos enviados por transacao em ssd1306_command_list
+#define SSD1306_COMMAND_BATCH 32
+
+// Palavras da transferencia assincrona seguem o formato do registrador
+// IC_DATA_CMD do RP2040: byte nos bits 0-7, STOP no bit 9 e RESTART no bit 10
+#define SSD1306_WORD_STOP    (1u << 9)
+#define SSD1306_WORD_RESTART (1u << 10)
+
 typedef enum {
   SET_CONTRAST = 0x81,
   SET_ENTIRE_ON = 0xA4,
@@ -25,25 +39,72 @@ typedef enum {
   SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
+// Backend de transferencia assincrona (DMA no RP2040, simulado no host).
+// start() inicia o envio de len palavras para o endereco; busy() informa se
+// a transferencia, incluindo o STOP no barramento, ainda esta em andamento.
 typedef struct {
+  void (*start)(void *ctx, uint8_t address, const uint16_t *words, size_t len);
+  bool (*busy)(void *ctx);
+  void *ctx;
+} ssd1306_async_backend_t;
+
+typedef struct ssd1306 ssd1306_t;
+typedef void (*ssd1306_async_callback_t)(ssd1306_t *ssd, void *user);
+
+struct ssd1306 {
   uint8_t width, height, pages, address;
-  i2c_inst_t *i2c_port;
+  hal_i2c_t *i2c_port;
   bool external_vcc;
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
-} ssd1306_t;
+  uint8_t *tx_buffer;
+  uint8_t *shadow_buffer;
+  bool shadow_valid;
+  uint8_t dirty_x0, dirty_x1, dirty_page0, dirty_page1;
+  int16_t clip_x0, clip_y0, clip_x1, clip_y1;   // Area de recorte, inclusiva
+  const ssd1306_async_backend_t *async_backend;
+  uint16_t *async_buffer;   // Segundo quadro: copia em transmissao enquanto ram_buffer e redesenhado
+  size_t async_len, async_capacity;
+  bool async_busy;
+  ssd1306_async_callback_t async_callback;
+  void *async_user;
+};
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, hal_i2c_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t count);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_send_dirty(ssd1306_t *ssd);
+void ssd1306_send_diff(ssd1306_t *ssd);
+
+void ssd1306_set_async_backend(ssd1306_t *ssd, const ssd1306_async_backend_t *backend);
+void ssd1306_set_async_callback(ssd1306_t *ssd, ssd1306_async_callback_t callback, void *user);
+void ssd1306_send_data_async(ssd1306_t *ssd);
+void ssd1306_send_diff_async(ssd1306_t *ssd);
+bool ssd1306_busy(ssd1306_t *ssd);
+void ssd1306_wait(ssd1306_t *ssd);
 
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
+void ssd1306_set_clip(ssd1306_t *ssd, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+void ssd1306_reset_clip(ssd1306_t *ssd);
+
+void ssd1306_pixel(ssd1306_t *ssd, int16_t x, int16_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
-void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
-void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
-void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
+void ssd1306_fill_rect(ssd1306_t *ssd, int16_t top, int16_t left, int16_t width, int16_t height, bool value);
+void ssd1306_rect(ssd1306_t *ssd, int16_t top, int16_t left, int16_t width, int16_t height, bool value, bool fill);
+void ssd1306_line(ssd1306_t *ssd, int16_t x0, int16_t y0, int16_t x1, int16_t y1, bool value);
+void ssd1306_hline(ssd1306_t *ssd, int16_t x0, int16_t x1, int16_t y, bool value);
+void ssd1306_vline(ssd1306_t *ssd, int16_t x, int16_t y0, int16_t y1, bool value);
+// Blocos de paginas inteiras, coluna a coluna como o framebuffer: pages
+// bytes por coluna, a partir da coluna x e da pagina page. So os pixels
+// dentro do retangulo de recorte sao copiados, nos dois sentidos; o resto
+// do destino fica como estava
+void ssd1306_read_pages(const ssd1306_t *ssd, int16_t x, uint8_t page, uint8_t width, uint8_t pages, uint8_t *dst);
+void ssd1306_write_pages(ssd1306_t *ssd, int16_t x, uint8_t page, uint8_t width, uint8_t pages, const uint8_t *src);
+void ssd1306_draw_char(ssd1306_t *ssd, char c, int16_t x, int16_t y);
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, int16_t x, int16_t y);
+int16_t ssd1306_draw_text(ssd1306_t *ssd, const font_t *font, const char *str, int16_t x, int16_t y);
+uint16_t ssd1306_text_width(const font_t *font, const char *str);
+
+#endif
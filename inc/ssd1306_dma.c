@@ -0,0 +1,40 @@
+#include "ssd1306_dma.h"
+
+static void ssd1306_dma_start(void *ctx, uint8_t address, const uint16_t *words, size_t len) {
+  ssd1306_dma_t *dma = ctx;
+  i2c_hw_t *hw = i2c_get_hw(dma->i2c);
+
+  // O endereco do escravo so pode ser trocado com o controlador desabilitado
+  hw->enable = 0;
+  hw->tar = address;
+  hw->enable = 1;
+
+  // Limpa STOP/abort da transferencia anterior para que busy() acompanhe esta
+  (void)hw->clr_stop_det;
+  (void)hw->clr_tx_abrt;
+
+  dma_channel_configure(dma->channel, &dma->config, &hw->data_cmd, words, len, true);
+}
+
+static bool ssd1306_dma_busy(void *ctx) {
+  ssd1306_dma_t *dma = ctx;
+  if (dma_channel_is_busy(dma->channel))
+    return true;
+  // A FIFO ainda pode estar esvaziando: so termina apos o STOP no barramento
+  return !(i2c_get_hw(dma->i2c)->raw_intr_stat & I2C_IC_RAW_INTR_STAT_STOP_DET_BITS);
+}
+
+const ssd1306_async_backend_t *ssd1306_dma_init(ssd1306_dma_t *dma, i2c_inst_t *i2c) {
+  dma->i2c = i2c;
+  dma->channel = dma_claim_unused_channel(true);
+  dma->config = dma_channel_get_default_config(dma->channel);
+  channel_config_set_transfer_data_size(&dma->config, DMA_SIZE_16);
+  channel_config_set_read_increment(&dma->config, true);
+  channel_config_set_write_increment(&dma->config, false);
+  channel_config_set_dreq(&dma->config, i2c_get_dreq(i2c, true));
+
+  dma->backend.start = ssd1306_dma_start;
+  dma->backend.busy = ssd1306_dma_busy;
+  dma->backend.ctx = dma;
+  return &dma->backend;
+}
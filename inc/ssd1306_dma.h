@@ -0,0 +1,18 @@
+#ifndef SSD1306_DMA_H
+#define SSD1306_DMA_H
+
+#include "hardware/dma.h"
+#include "ssd1306.h"
+
+// Backend assincrono do SSD1306 no RP2040: um canal de DMA alimenta a FIFO
+// de transmissao do I2C (registrador IC_DATA_CMD) com as palavras do quadro
+typedef struct {
+  i2c_inst_t *i2c;
+  uint channel;
+  dma_channel_config config;
+  ssd1306_async_backend_t backend;
+} ssd1306_dma_t;
+
+const ssd1306_async_backend_t *ssd1306_dma_init(ssd1306_dma_t *dma, i2c_inst_t *i2c);
+
+#endif
@@ -0,0 +1,261 @@
+#include <stdio.h>
+#include <string.h>
+#include "ssd1306_emu.h"
+
+void ssd1306_emu_init(ssd1306_emu_t *emu, uint8_t address) {
+  memset(emu, 0, sizeof(*emu));
+  emu->address = address;
+  // Valores de reset do datasheet
+  emu->mem_mode = 2;
+  emu->col_end = SSD1306_EMU_WIDTH - 1;
+  emu->page_end = SSD1306_EMU_PAGES - 1;
+  emu->mux = SSD1306_EMU_HEIGHT - 1;
+  emu->com_pins = 0x12;
+  emu->contrast = 0x7F;
+}
+
+// Argumentos esperados depois do byte de comando
+static uint8_t ssd1306_emu_args(uint8_t cmd) {
+  switch (cmd) {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+    case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+      return 1;
+    case 0x21: case 0x22: case 0xA3:
+      return 2;
+    case 0x26: case 0x27:
+      return 6;
+    case 0x29: case 0x2A:
+      return 5;
+    default:
+      return 0;
+  }
+}
+
+static void ssd1306_emu_execute(ssd1306_emu_t *emu) {
+  const uint8_t *c = emu->cmd;
+  switch (c[0]) {
+    case 0x20: emu->mem_mode = c[1] & 0x03; break;
+    case 0x21:
+      emu->col_start = emu->col = c[1] & 0x7F;
+      emu->col_end = c[2] & 0x7F;
+      break;
+    case 0x22:
+      emu->page_start = emu->page = c[1] & 0x07;
+      emu->page_end = c[2] & 0x07;
+      break;
+    case 0x81: emu->contrast = c[1]; break;
+    case 0x8D: emu->charge_pump = (c[1] & 0x04) != 0; break;
+    case 0xA8: if ((c[1] & 0x3F) >= 15) emu->mux = c[1] & 0x3F; break;
+    case 0xD3: emu->offset = c[1] & 0x3F; break;
+    case 0xDA: emu->com_pins = c[1]; break;
+    case 0xA0: case 0xA1: emu->seg_remap = c[0] & 1; break;
+    case 0xA4: case 0xA5: emu->entire_on = c[0] & 1; break;
+    case 0xA6: case 0xA7: emu->invert = c[0] & 1; break;
+    case 0xAE: case 0xAF: emu->display_on = c[0] & 1; break;
+    case 0xC0: case 0xC8: emu->com_remap = (c[0] & 0x08) != 0; break;
+    // Temporizacao analogica e rolagem nao afetam a GDDRAM
+    case 0xD5: case 0xD9: case 0xDB: case 0xA3:
+    case 0x26: case 0x27: case 0x29: case 0x2A: case 0x2E: case 0x2F: case 0xE3:
+      break;
+    default:
+      if (c[0] >= 0x40 && c[0] <= 0x7F)
+        emu->start_line = c[0] & 0x3F;
+      else if (c[0] >= 0xB0 && c[0] <= 0xB7)
+        emu->page = c[0] & 0x07;
+      else if (c[0] <= 0x0F)
+        emu->col = (emu->col & 0xF0) | c[0];
+      else if (c[0] <= 0x1F)
+        emu->col = ((c[0] & 0x07) << 4) | (emu->col & 0x0F);
+      else
+        emu->unknown_commands++;
+      break;
+  }
+}
+
+static void ssd1306_emu_command(ssd1306_emu_t *emu, uint8_t byte) {
+  emu->frame.command_bytes++;
+  if (!emu->cmd_need) {
+    emu->cmd[0] = byte;
+    emu->cmd_len = 1;
+    emu->cmd_need = ssd1306_emu_args(byte);
+  } else {
+    emu->cmd[emu->cmd_len++] = byte;
+    emu->cmd_need--;
+  }
+  if (!emu->cmd_need)
+    ssd1306_emu_execute(emu);
+}
+
+// Grava um byte e avanca o ponteiro conforme o modo de enderecamento
+static void ssd1306_emu_data(ssd1306_emu_t *emu, uint8_t byte) {
+  emu->frame.data_bytes++;
+  emu->gddram[emu->page][emu->col] = byte;
+  switch (emu->mem_mode) {
+    case 0:   // Horizontal: coluna, depois pagina
+      if (emu->col == emu->col_end) {
+        emu->col = emu->col_start;
+        emu->page = emu->page == emu->page_end ? emu->page_start : (emu->page + 1) & 0x07;
+      } else {
+        emu->col = (emu->col + 1) & 0x7F;
+      }
+      break;
+    case 1:   // Vertical: pagina, depois coluna
+      if (emu->page == emu->page_end) {
+        emu->page = emu->page_start;
+        emu->col = emu->col == emu->col_end ? emu->col_start : (emu->col + 1) & 0x7F;
+      } else {
+        emu->page = (emu->page + 1) & 0x07;
+      }
+      break;
+    default:  // Paginas: so a coluna avanca, voltando ao inicio da janela
+      emu->col = emu->col == emu->col_end ? emu->col_start : (emu->col + 1) & 0x7F;
+      break;
+  }
+}
+
+// START/RESTART + endereco com ACK
+static void ssd1306_emu_start(ssd1306_emu_t *emu, uint8_t address) {
+  emu->frame.transactions++;
+  emu->frame.bytes++;
+  emu->frame.bits += 1 + 9;
+  emu->addressed = address == emu->address;
+  emu->control_state = 0;
+  if (!emu->addressed)
+    emu->nacks++;
+}
+
+// Um byte com ACK: controle, ou dado/comando conforme o ultimo controle
+static void ssd1306_emu_byte(ssd1306_emu_t *emu, uint8_t byte) {
+  emu->frame.bytes++;
+  emu->frame.bits += 9;
+  if (!emu->addressed)
+    return;
+  if (!emu->control_state) {
+    // Co = 1: um unico byte e depois outro byte de controle; Co = 0: o
+    // restante da transacao e todo dado ou todo comando
+    emu->control = byte;
+    emu->control_state = byte & 0x80 ? 1 : 2;
+    return;
+  }
+  if (emu->control & 0x40)
+    ssd1306_emu_data(emu, byte);
+  else
+    ssd1306_emu_command(emu, byte);
+  if (emu->control_state == 1)
+    emu->control_state = 0;
+}
+
+// Fim da transacao: STOP, ou barramento preso ate o proximo RESTART
+static void ssd1306_emu_finish(ssd1306_emu_t *emu, bool stop) {
+  if (stop)
+    emu->frame.bits++;
+  emu->restart = !stop;
+}
+
+void ssd1306_emu_write(ssd1306_emu_t *emu, uint8_t address, const uint8_t *data, size_t len, bool nostop) {
+  ssd1306_emu_start(emu, address);
+  for (size_t i = 0; i < len; ++i)
+    ssd1306_emu_byte(emu, data[i]);
+  ssd1306_emu_finish(emu, !nostop);
+}
+
+void ssd1306_emu_i2c_sink(void *user, uint8_t address, const uint8_t *data, size_t len, bool nostop) {
+  ssd1306_emu_write((ssd1306_emu_t *)user, address, data, len, nostop);
+}
+
+void ssd1306_emu_write_words(ssd1306_emu_t *emu, uint8_t address, const uint16_t *words, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    uint16_t w = words[i];
+    bool restart = w & SSD1306_WORD_RESTART;
+    if (i == 0 || restart || (words[i - 1] & SSD1306_WORD_STOP)) {
+      // Nova transacao: depois de um STOP so cabe START; com o barramento
+      // preso (escrita anterior sem STOP) so cabe RESTART
+      if (i > 0 && !(words[i - 1] & SSD1306_WORD_STOP))
+        ssd1306_emu_finish(emu, false);
+      if (restart != emu->restart)
+        emu->framing_errors++;
+      ssd1306_emu_start(emu, address);
+    }
+    ssd1306_emu_byte(emu, w & 0xFF);
+    if (w & SSD1306_WORD_STOP)
+      ssd1306_emu_finish(emu, true);
+  }
+  if (len && !(words[len - 1] & SSD1306_WORD_STOP))
+    ssd1306_emu_finish(emu, false);
+}
+
+static void ssd1306_emu_async_start(void *ctx, uint8_t address, const uint16_t *words, size_t len) {
+  ssd1306_emu_write_words((ssd1306_emu_t *)ctx, address, words, len);
+}
+
+static bool ssd1306_emu_async_busy(void *ctx) {
+  return false;
+}
+
+const ssd1306_async_backend_t *ssd1306_emu_async_backend(ssd1306_emu_t *emu) {
+  emu->backend.start = ssd1306_emu_async_start;
+  emu->backend.busy = ssd1306_emu_async_busy;
+  emu->backend.ctx = emu;
+  return &emu->backend;
+}
+
+bool ssd1306_emu_pixel(const ssd1306_emu_t *emu, int x, int y) {
+  if (!emu->display_on || x < 0 || x >= SSD1306_EMU_WIDTH || y < 0 || y >= SSD1306_EMU_HEIGHT)
+    return false;
+
+  // Linha do vidro -> saida COM; no modulo o topo e ligado a COM63 e a
+  // esquerda a SEG127
+  int com = SSD1306_EMU_HEIGHT - 1 - y;
+  if (!(emu->com_pins & 0x10)) {
+    // Configuracao sequencial em um vidro ligado de forma alternada: as
+    // linhas pares e impares vem de metades diferentes
+    com = (com & 1) ? 32 + (com >> 1) : com >> 1;
+  }
+  if (emu->com_pins & 0x20)
+    com ^= 32;
+
+  // Saida COM -> linha da varredura (0xC8 varre de COM[mux] a COM0)
+  int scan = emu->com_remap ? emu->mux - com : com;
+  if (scan < 0 || scan > emu->mux)
+    return false;
+  int row = (scan + emu->offset + emu->start_line) & 0x3F;
+
+  int seg = SSD1306_EMU_WIDTH - 1 - x;
+  int col = emu->seg_remap ? SSD1306_EMU_WIDTH - 1 - seg : seg;
+
+  bool on = emu->entire_on || ((emu->gddram[row >> 3][col] >> (row & 7)) & 1);
+  return on != emu->invert;
+}
+
+void ssd1306_emu_end_frame(ssd1306_emu_t *emu, ssd1306_bus_stats_t *out) {
+  if (emu->restart)
+    emu->framing_errors++;
+  if (out)
+    *out = emu->frame;
+  emu->total.transactions += emu->frame.transactions;
+  emu->total.bytes += emu->frame.bytes;
+  emu->total.data_bytes += emu->frame.data_bytes;
+  emu->total.command_bytes += emu->frame.command_bytes;
+  emu->total.bits += emu->frame.bits;
+  emu->frames++;
+  memset(&emu->frame, 0, sizeof(emu->frame));
+}
+
+uint32_t ssd1306_bus_time_us(const ssd1306_bus_stats_t *stats, uint32_t scl_hz) {
+  return (uint32_t)((stats->bits * 1000000u + scl_hz - 1) / scl_hz);
+}
+
+bool ssd1306_emu_write_pbm(const ssd1306_emu_t *emu, const char *path) {
+  FILE *f = fopen(path, "wb");
+  if (!f)
+    return false;
+  fprintf(f, "P4\n%d %d\n", SSD1306_EMU_WIDTH, SSD1306_EMU_HEIGHT);
+  for (int y = 0; y < SSD1306_EMU_HEIGHT; ++y) {
+    uint8_t row[SSD1306_EMU_WIDTH / 8] = { 0 };
+    for (int x = 0; x < SSD1306_EMU_WIDTH; ++x)
+      if (ssd1306_emu_pixel(emu, x, y))
+        row[x >> 3] |= 0x80 >> (x & 7);
+    fwrite(row, 1, sizeof(row), f);
+  }
+  return fclose(f) == 0;
+}
@@ -0,0 +1,91 @@
+#ifndef SSD1306_EMU_H
+#define SSD1306_EMU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "ssd1306.h"
+
+#define SSD1306_EMU_WIDTH 128
+#define SSD1306_EMU_PAGES 8
+#define SSD1306_EMU_HEIGHT (SSD1306_EMU_PAGES * 8)
+
+// Trafego no barramento; bits conta START/RESTART, endereco, dados com ACK
+// (9 bits por byte) e STOP, para estimar o tempo de fio em cada clock
+typedef struct {
+  uint32_t transactions;    // START ou RESTART com endereco
+  uint32_t bytes;           // Bytes transmitidos, incluindo o endereco
+  uint32_t data_bytes;      // Bytes gravados na GDDRAM
+  uint32_t command_bytes;   // Bytes de comando (incluindo argumentos)
+  uint64_t bits;
+} ssd1306_bus_stats_t;
+
+// Modelo do SSD1306 que decodifica as escritas I2C (bytes de controle
+// 0x80/0x00/0x40/0xC0, comandos com argumentos, modos de enderecamento e
+// janelas) e mantem a GDDRAM. A imagem visivel considera o modulo comum de
+// 128x64, em que o remapeamento de segmentos (0xA1) e a varredura invertida
+// (0xC8) deixam a imagem na orientacao da GDDRAM.
+typedef struct {
+  uint8_t address;
+  uint8_t gddram[SSD1306_EMU_PAGES][SSD1306_EMU_WIDTH];
+
+  // Registradores
+  uint8_t mem_mode;         // 0 horizontal, 1 vertical, 2 paginas
+  uint8_t col_start, col_end, page_start, page_end;
+  uint8_t col, page;        // Ponteiro de escrita
+  uint8_t start_line, offset, mux, com_pins, contrast;
+  bool seg_remap, com_remap, invert, entire_on, display_on, charge_pump;
+
+  // Comando em andamento (os argumentos podem vir em transacoes separadas)
+  uint8_t cmd[8];
+  uint8_t cmd_len, cmd_need;
+
+  // Transacao em andamento
+  bool addressed;           // Endereco reconhecido (ACK)
+  uint8_t control;          // Ultimo byte de controle
+  uint8_t control_state;    // 0 espera controle, 1 um byte (Co = 1), 2 o resto
+
+  bool restart;             // A escrita anterior terminou sem STOP
+  uint32_t nacks;           // Transacoes para outro endereco
+  uint32_t unknown_commands;
+  // RESTART sem transacao aberta, START com o barramento ainda preso por
+  // uma escrita sem STOP, ou quadro fechado sem STOP
+  uint32_t framing_errors;
+  ssd1306_async_backend_t backend;
+  ssd1306_bus_stats_t frame, total;
+  uint32_t frames;
+} ssd1306_emu_t;
+
+void ssd1306_emu_init(ssd1306_emu_t *emu, uint8_t address);
+
+// Uma transacao de escrita (START, endereco, bytes e STOP se !nostop)
+void ssd1306_emu_write(ssd1306_emu_t *emu, uint8_t address, const uint8_t *data, size_t len, bool nostop);
+
+// Adaptador com a assinatura de hal_host_set_i2c_sink (user = ssd1306_emu_t *)
+void ssd1306_emu_i2c_sink(void *user, uint8_t address, const uint8_t *data, size_t len, bool nostop);
+
+// Palavras no formato IC_DATA_CMD (SSD1306_WORD_RESTART/STOP), como a
+// transferencia assincrona as envia; confere o enquadramento com o estado
+// deixado pela escrita anterior e conta as violacoes em framing_errors
+void ssd1306_emu_write_words(ssd1306_emu_t *emu, uint8_t address, const uint16_t *words, size_t len);
+
+// Backend assincrono para ssd1306_set_async_backend que entrega as palavras
+// ao emulador na hora; a transferencia termina imediatamente
+const ssd1306_async_backend_t *ssd1306_emu_async_backend(ssd1306_emu_t *emu);
+
+// Pixel aceso na tela, ja com inversao, "tudo aceso", display ligado,
+// linha inicial, offset, multiplex, mapeamento de COM e remapeamentos
+bool ssd1306_emu_pixel(const ssd1306_emu_t *emu, int x, int y);
+
+// Fecha o quadro: copia as estatisticas do quadro para out (se nao nulo),
+// acumula no total e zera o quadro. Um quadro que termina com o barramento
+// preso (escrita sem STOP) conta em framing_errors
+void ssd1306_emu_end_frame(ssd1306_emu_t *emu, ssd1306_bus_stats_t *out);
+
+// Tempo estimado no fio para um clock SCL em Hz (100000, 400000, 1000000)
+uint32_t ssd1306_bus_time_us(const ssd1306_bus_stats_t *stats, uint32_t scl_hz);
+
+// Grava a imagem visivel como PBM binario (P4); false em erro de E/S
+bool ssd1306_emu_write_pbm(const ssd1306_emu_t *emu, const char *path);
+
+#endif
@@ -0,0 +1,42 @@
+#include "triple_buffer.h"
+
+#define SLOT_MASK 3u
+
+void triple_buffer_init(triple_buffer_t *tb) {
+  atomic_init(&tb->latest, 0);
+  atomic_init(&tb->reading, 0);
+  tb->writing = 1;
+  tb->seen = 0;
+}
+
+// O par "store latest; barreira; load reading" no produtor e "store reading;
+// barreira; load latest" no consumidor garante que ao menos um lado ve o
+// store do outro. Se o consumidor confirmou latest, o produtor enxerga o
+// slot em leitura e nao o escolhe para escrever.
+void triple_buffer_publish(triple_buffer_t *tb) {
+  uint32_t seq = (atomic_load_explicit(&tb->latest, memory_order_relaxed) >> 2) + 1;
+  uint8_t published = tb->writing;
+  atomic_store_explicit(&tb->latest, (seq << 2) | published, memory_order_release);
+  atomic_thread_fence(memory_order_seq_cst);
+  uint8_t reading = atomic_load_explicit(&tb->reading, memory_order_relaxed);
+
+  // Proximo slot de escrita: o que nao e o publicado nem o em leitura
+  // (slots 0 + 1 + 2 = 3)
+  tb->writing = reading != published ? 3 - reading - published : (published + 1) % 3;
+}
+
+bool triple_buffer_acquire(triple_buffer_t *tb, uint8_t *slot) {
+  uint32_t latest = atomic_load_explicit(&tb->latest, memory_order_acquire);
+  for (;;) {
+    atomic_store_explicit(&tb->reading, latest & SLOT_MASK, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    uint32_t check = atomic_load_explicit(&tb->latest, memory_order_acquire);
+    if (check == latest)
+      break;
+    latest = check;
+  }
+  *slot = latest & SLOT_MASK;
+  bool fresh = (latest >> 2) != tb->seen;
+  tb->seen = latest >> 2;
+  return fresh;
+}
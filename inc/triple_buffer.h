@@ -0,0 +1,34 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Troca de instantaneos entre um produtor e um consumidor (um por nucleo)
+// com tres slots guardados pelo usuario: o ultimo publicado vence. O
+// produtor nunca espera; o consumidor so repete a aquisicao se uma
+// publicacao ocorrer no meio dela. Usa apenas loads/stores atomicos e
+// barreiras, sem CAS (o Cortex-M0+ nao tem LDREX/STREX).
+typedef struct {
+  _Atomic uint32_t latest;    // (sequencia << 2) | slot publicado mais recente
+  _Atomic uint32_t reading;   // Slot em uso pelo consumidor
+  uint8_t writing;            // Slot em escrita pelo produtor (so o produtor acessa)
+  uint32_t seen;              // Ultima sequencia adquirida (so o consumidor acessa)
+} triple_buffer_t;
+
+// Slot 0 comeca publicado e em leitura; o produtor escreve primeiro no 1
+void triple_buffer_init(triple_buffer_t *tb);
+
+// Produtor: slot a preencher antes de triple_buffer_publish
+static inline uint8_t triple_buffer_write_slot(const triple_buffer_t *tb) {
+  return tb->writing;
+}
+
+void triple_buffer_publish(triple_buffer_t *tb);
+
+// Consumidor: slot com o instantaneo mais recente, valido ate a proxima
+// aquisicao; retorna true se houve publicacao desde a aquisicao anterior
+bool triple_buffer_acquire(triple_buffer_t *tb, uint8_t *slot);
+
+#endif
@@ -0,0 +1,159 @@
+// Filtro dos eixos (decimacao + one-euro) com a configuracao do firmware,
+// alimentado por sinais com o ruido do ADC do joystick: jitter e vies em
+// repouso, atraso e overshoot da resposta a degraus grandes e pequenos. Tambem
+// a decimacao sem IIR (exata) e o coeficiente do IIR contra a formula em
+// ponto flutuante.
+#include <math.h>
+#include <stdlib.h>
+#include "test.h"
+#include "inc/app_config.h"
+
+// Ruido do ADC do joystick em repouso, uniforme em +-NOISE contagens
+#define NOISE 30
+#define JOYSTICK_FILTER_DECIMATION 4
+#define OUTPUT_RATE (JOYSTICK_SAMPLE_RATE >> JOYSTICK_FILTER_DECIMATION)
+
+// Limites, em LSB de 12 bits (o ruido de entrada tem 60 de pico a pico)
+#define REST_PEAK_TO_PEAK 5.0
+#define REST_BIAS 0.25
+#define STEP_RISE_MS 20.0      // 90% de um degrau de mais de 1000 contagens
+#define STEP_SETTLE_MS 50.0    // Ate ficar a menos de 10 LSB
+#define STEP_OVERSHOOT 8.0
+#define SMALL_STEP_RISE_MS 150.0  // 90% de um degrau de 100 contagens
+
+static uint32_t seed = 0xA715u;
+
+static uint16_t noisy(int32_t level) {
+  return (uint16_t)(level + (int32_t)(test_random(&seed) % (2 * NOISE + 1)) - NOISE);
+}
+
+// Saida na escala do ADC (12 bits), com fracao
+static double value_lsb12(const axis_filter_t *f) {
+  return f->value_q8 / 256.0 / 16.0;
+}
+
+// Empurra amostras ate a proxima saida
+static void next_output(axis_filter_t *f, int32_t level) {
+  while (!axis_filter_push(f, noisy(level)))
+    ;
+}
+
+static void check_rest(void) {
+  // Parado no centro, fora dele e perto dos extremos: pico a pico e media
+  // da saida durante 10 s, depois de 1 s para assentar
+  static const int32_t levels[] = { 2048, 1987, 300, 3800 };
+  for (size_t i = 0; i < count_of(levels); ++i) {
+    axis_filter_t f;
+    axis_filter_init(&f, &JOYSTICK_FILTER);
+    for (int n = 0; n < OUTPUT_RATE; ++n)
+      next_output(&f, levels[i]);
+    double lo = 1e9, hi = -1e9, sum = 0;
+    int outputs = 10 * OUTPUT_RATE;
+    for (int n = 0; n < outputs; ++n) {
+      next_output(&f, levels[i]);
+      double v = value_lsb12(&f);
+      lo = v < lo ? v : lo;
+      hi = v > hi ? v : hi;
+      sum += v;
+    }
+    double bias = sum / outputs - levels[i];
+    printf("repouso em %4ld: %.2f LSB de pico a pico, vies %+.3f\n", (long)levels[i], hi - lo, bias);
+    CHECK(hi - lo <= REST_PEAK_TO_PEAK, "repouso em %ld: %.2f LSB de pico a pico", (long)levels[i], hi - lo);
+    CHECK(fabs(bias) <= REST_BIAS, "repouso em %ld: vies de %.3f LSB", (long)levels[i], bias);
+  }
+}
+
+static void check_step(void) {
+  static const int32_t steps[][2] = { { 2048, 3500 }, { 3500, 2048 }, { 100, 3995 }, { 2048, 2148 }, { 2148, 2048 } };
+  for (size_t i = 0; i < count_of(steps); ++i) {
+    axis_filter_t f;
+    axis_filter_init(&f, &JOYSTICK_FILTER);
+    int32_t from = steps[i][0], to = steps[i][1];
+    for (int n = 0; n < OUTPUT_RATE; ++n)
+      next_output(&f, from);
+
+    int rise = 0, settle = 0;
+    double overshoot = 0;
+    for (int n = 1; n <= OUTPUT_RATE; ++n) {
+      next_output(&f, to);
+      double v = value_lsb12(&f);
+      if (!rise && (v - from) / (to - from) >= 0.9)
+        rise = n;
+      double past = to > from ? v - to : to - v;
+      overshoot = past > overshoot ? past : overshoot;
+      if (fabs(v - to) > 10)
+        settle = 0;
+      else if (!settle)
+        settle = n;
+    }
+    double rise_ms = rise * 1000.0 / OUTPUT_RATE, settle_ms = settle * 1000.0 / OUTPUT_RATE;
+    printf("degrau %4ld -> %4ld: 90%% em %5.1f ms, a 10 LSB em %5.1f ms, overshoot %.2f LSB\n", (long)from,
+           (long)to, rise_ms, settle_ms, overshoot);
+    CHECK(rise && settle, "degrau %ld -> %ld nao chegou ao destino em 1 s", (long)from, (long)to);
+    if (abs(to - from) > 1000) {
+      CHECK(rise_ms <= STEP_RISE_MS, "degrau %ld -> %ld: 90%% em %.1f ms", (long)from, (long)to, rise_ms);
+      CHECK(settle_ms <= STEP_SETTLE_MS, "degrau %ld -> %ld: 10 LSB em %.1f ms", (long)from, (long)to, settle_ms);
+    } else {
+      CHECK(rise_ms <= SMALL_STEP_RISE_MS, "degrau %ld -> %ld: 90%% em %.1f ms", (long)from, (long)to, rise_ms);
+    }
+    CHECK(overshoot <= STEP_OVERSHOOT, "degrau %ld -> %ld: overshoot de %.2f LSB", (long)from, (long)to,
+          overshoot);
+  }
+}
+
+static void check_decimation(void) {
+  // Sem IIR a saida e a media exata do bloco na escala de 16 bits, para
+  // qualquer fator de decimacao; 4095 chega a 65520
+  for (uint8_t k = 0; k <= 8; ++k) {
+    axis_filter_config_t config = { .decimation_log2 = k, .input_rate = JOYSTICK_SAMPLE_RATE };
+    axis_filter_t f;
+    axis_filter_init(&f, &config);
+    CHECK_EQ(axis_filter_value(&f), 32768);
+    uint32_t s = 0xDEC1u + k;
+    for (int block = 0; block < 200; ++block) {
+      uint32_t sum = 0;
+      bool out = false;
+      for (unsigned n = 0; n < 1u << k; ++n) {
+        uint16_t sample = block == 0 ? 4095 : block == 1 ? 0 : test_random(&s) & 4095;
+        sum += sample;
+        CHECK(out == false, "k = %u: saida antes do fim do bloco", k);
+        out = axis_filter_push(&f, sample);
+      }
+      CHECK(out, "k = %u: bloco sem saida", k);
+      uint32_t want = k >= 4 ? sum >> (k - 4) : sum << (4 - k);
+      CHECK(axis_filter_value(&f) == want, "k = %u, bloco %d: %u, esperado %lu", k, block,
+            axis_filter_value(&f), (unsigned long)want);
+    }
+  }
+}
+
+static void check_alpha(void) {
+  // Sem decimacao e com beta = 0 um degrau de 0 a 65520 move a saida de
+  // alpha * 65520: compara alpha com 1 / (1 + rate / (2*pi*fc)) em Q16
+  static const uint32_t rates[] = { 100, 625, 1000, 10000, 50000, 500000 };
+  double worst = 0;
+  for (size_t r = 0; r < count_of(rates); ++r)
+    for (uint32_t cutoff_q8 = 16; cutoff_q8 <= rates[r] << 8; cutoff_q8 += cutoff_q8 / 16 + 1) {
+      axis_filter_config_t config = { .input_rate = rates[r], .min_cutoff_q8 = cutoff_q8 };
+      axis_filter_t f;
+      axis_filter_init(&f, &config);
+      axis_filter_push(&f, 0);
+      axis_filter_push(&f, 4095);
+      double alpha = f.value_q8 * 65536.0 / (65520 << 8);
+      double exact = 65536.0 / (1.0 + rates[r] / (2 * M_PI * cutoff_q8 / 256.0));
+      double error = fabs(alpha - exact);
+      worst = error > worst ? error : worst;
+      CHECK(error <= 2, "alpha com corte %.3f Hz a %lu Hz: %.2f, esperado %.2f (Q16)", cutoff_q8 / 256.0,
+            (unsigned long)rates[r], alpha, exact);
+    }
+  printf("alpha: erro maximo de %.2f em Q16\n", worst);
+}
+
+int main(void) {
+  CHECK_EQ(JOYSTICK_FILTER.decimation_log2, JOYSTICK_FILTER_DECIMATION);
+  check_rest();
+  check_step();
+  check_decimation();
+  check_alpha();
+  return TEST_RESULT();
+}
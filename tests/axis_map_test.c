@@ -0,0 +1,81 @@
+// axis_map pelo caminho do interpolador (blend no interp0, clamp no interp1),
+// com o modelo de tests/interp_model.c, contra axis_map_portable: todas as
+// entradas da faixa normalizada e entradas aleatorias bem fora dela, para
+// cada mapeamento do firmware, com e sem a curva e a zona morta
+#include "test.h"
+#include "hardware/interp.h"
+#include "inc/app_config.h"
+
+static void check_model(void) {
+  // Exemplos da secao 2.3.1.6 do datasheet
+  interp_config cfg = interp_default_config();
+  interp_config_set_blend(&cfg, true);
+  interp_set_config(interp0, 0, &cfg);
+  cfg = interp_default_config();
+  interp_set_config(interp0, 1, &cfg);
+  interp0->base[0] = 500;
+  interp0->base[1] = 1000;
+  interp0->accum[1] = 0x180;    // alpha = 0x80, bits acima de 7 ignorados
+  CHECK_EQ(interp_peek_lane_result(interp0, 1), 750);
+
+  cfg = interp_default_config();
+  interp_config_set_clamp(&cfg, true);
+  interp_config_set_shift(&cfg, 16);
+  interp_config_set_mask(&cfg, 0, 15);
+  interp_config_set_signed(&cfg, true);
+  interp_set_config(interp1, 0, &cfg);
+  interp1->base[0] = (uint32_t)-100;
+  interp1->base[1] = 100;
+  interp1->accum[0] = 0xFFF00000u;   // -16
+  CHECK_EQ((int32_t)interp_peek_lane_result(interp1, 0), -16);
+  interp1->accum[0] = 0x80000000u;   // -32768
+  CHECK_EQ((int32_t)interp_peek_lane_result(interp1, 0), -100);
+  interp1->accum[0] = 0x00FF0000u;   // 255
+  CHECK_EQ((int32_t)interp_peek_lane_result(interp1, 0), 100);
+}
+
+static void check_config(const char *name, const axis_map_config_t *config) {
+  axis_map_t map;
+  axis_map_init(&map, config);
+  axis_map_hw_init();
+
+  unsigned before = test_failures;
+  for (int32_t in = -CALIBRATION_FULL - 4096; in <= CALIBRATION_FULL + 4096; ++in)
+    CHECK(axis_map(&map, in) == axis_map_portable(&map, in), "%s(%ld): interp %ld, portavel %ld", name,
+          (long)in, (long)axis_map(&map, in), (long)axis_map_portable(&map, in));
+
+  uint32_t seed = 0x12345678u;
+  for (int i = 0; i < 1000000; ++i) {
+    int32_t in = (int32_t)test_random(&seed) >> 1;
+    CHECK(axis_map(&map, in) == axis_map_portable(&map, in), "%s(%ld): interp %ld, portavel %ld", name,
+          (long)in, (long)axis_map(&map, in), (long)axis_map_portable(&map, in));
+  }
+  printf("%-28s %s\n", name, test_failures == before ? "ok" : "FALHOU");
+}
+
+int main(void) {
+  check_model();
+
+  static const struct {
+    const char *name;
+    const axis_map_config_t *config;
+  } shipped[] = {
+    { "MAP_SQUARE_X", &MAP_SQUARE_X },
+    { "MAP_SQUARE_Y", &MAP_SQUARE_Y },
+    { "MAP_LED", &MAP_LED },
+  };
+  char name[64];
+  for (size_t i = 0; i < count_of(shipped); ++i) {
+    axis_map_config_t config = *shipped[i].config;
+    check_config(shipped[i].name, &config);
+
+    // A curva passa pelo blend do interp0; a zona morta muda o span
+    config.curve = axis_curve_quadratic;
+    snprintf(name, sizeof(name), "%s+curva", shipped[i].name);
+    check_config(name, &config);
+    config.dead_zone = 1500;
+    snprintf(name, sizeof(name), "%s+curva+zona", shipped[i].name);
+    check_config(name, &config);
+  }
+  return TEST_RESULT();
+}
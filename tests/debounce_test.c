@@ -0,0 +1,233 @@
+// Debounce por contadores verticais: contra um modelo escalar (um contador
+// por pino) em todos os 32 pinos e para cada numero de amostras, e com a
+// temporizacao do firmware sobre formas de onda de botoes com repique: cada
+// aperto e cada soltura com repique mais curto que o tempo de acomodacao
+// geram exatamente uma mudanca, com atraso limitado e edge_us no inicio do
+// nivel estavel; pulsos espurios curtos nunca geram mudanca.
+#include <stdlib.h>
+#include "test.h"
+#include "inc/app_config.h"
+#include "inc/debounce.h"
+
+// SW_PIN e BUTTON_A_PIN do firmware
+#define BUTTON_PINS ((1u << 22) | (1u << 5))
+
+static uint32_t seed = 0xB0B0u;
+
+// ======= Modelo escalar =======
+static void check_against_model(uint32_t mask, uint8_t samples) {
+  debounce_t d;
+  uint32_t initial = test_random(&seed);
+  debounce_init(&d, mask, initial, 1000, samples * 1000);
+  CHECK_EQ(d.samples, samples);
+
+  uint32_t state = initial & mask;
+  uint8_t count[32] = { 0 };
+  // Probabilidade de troca por amostra diferente em cada pino, para haver
+  // sequencias curtas e longas
+  uint32_t flip_odds[32];
+  for (int pin = 0; pin < 32; ++pin)
+    flip_odds[pin] = 2 + test_random(&seed) % 40;
+  uint32_t raw = initial, now = 0xFFFF0000u;
+  for (int n = 0; n < 20000; ++n, now += 1000) {
+    for (int pin = 0; pin < 32; ++pin)
+      if (test_random(&seed) % flip_odds[pin] == 0)
+        raw ^= 1u << pin;
+    uint32_t want = 0;
+    for (int pin = 0; pin < 32; ++pin) {
+      if (!((mask >> pin) & 1))
+        continue;
+      if (((raw ^ state) >> pin) & 1) {
+        if (++count[pin] == samples) {
+          want |= 1u << pin;
+          count[pin] = 0;
+        }
+      } else {
+        count[pin] = 0;
+      }
+    }
+    state ^= want;
+
+    uint32_t changed = debounce_update(&d, raw, now);
+    if (changed != want || d.state != state) {
+      CHECK(false, "mascara %08lx, %u amostras, leitura %d: mudou %08lx, esperado %08lx", (unsigned long)mask,
+            samples, n, (unsigned long)changed, (unsigned long)want);
+      return;
+    }
+    if (changed)
+      CHECK(d.edge_us == now - (samples - 1) * 1000u, "%u amostras: edge_us %lu na leitura %lu", samples,
+            (unsigned long)d.edge_us, (unsigned long)now);
+  }
+}
+
+static void check_settle_rounding(void) {
+  debounce_t d;
+  debounce_init(&d, 1, 0, BUTTON_SAMPLE_US, BUTTON_SETTLE_US);
+  CHECK_EQ(d.samples, BUTTON_SETTLE_US / BUTTON_SAMPLE_US);
+  debounce_init(&d, 1, 0, 1000, 4001);
+  CHECK_EQ(d.samples, 5);
+  debounce_init(&d, 1, 0, 1000, 0);
+  CHECK_EQ(d.samples, 1);
+  debounce_init(&d, 1, 0, 1000, 1000000);
+  CHECK_EQ(d.samples, DEBOUNCE_MAX_SAMPLES);
+  debounce_init(&d, 1, 0, 0, 5);
+  CHECK(d.sample_us == 1 && d.samples == 5, "sample_us = 0: %lu us, %u amostras", (unsigned long)d.sample_us,
+        d.samples);
+}
+
+// ======= Formas de onda com repique =======
+#define SETTLE_SAMPLES (BUTTON_SETTLE_US / BUTTON_SAMPLE_US)
+// Repique e pulsos espurios sempre mais curtos que o tempo de acomodacao
+// menos uma amostra: nenhuma sequencia dentro deles chega a SETTLE_SAMPLES
+#define BOUNCE_MAX_US ((SETTLE_SAMPLES - 1) * BUTTON_SAMPLE_US - 1)
+#define MAX_TOGGLES 200000
+
+typedef struct {
+  uint32_t time_us;
+  bool level;
+} toggle_t;
+
+// Mudanca esperada: o contato comeca a mudar em start_us e fica estavel em
+// stable_us
+typedef struct {
+  uint32_t start_us, stable_us;
+  bool level;
+} press_t;
+
+typedef struct {
+  uint8_t pin;
+  toggle_t *toggles;
+  int toggle_count, next_toggle;
+  press_t *presses;
+  int press_count, next_press;
+  bool level;
+  int glitches;
+} button_t;
+
+static void add_toggle(button_t *b, uint32_t t, bool level) {
+  if (b->toggle_count < MAX_TOGGLES)
+    b->toggles[b->toggle_count++] = (toggle_t){ t, level };
+}
+
+// Repique de ate BOUNCE_MAX_US terminando no novo nivel; devolve o fim
+static uint32_t bounce(button_t *b, uint32_t t, bool level) {
+  uint32_t end = t + test_random(&seed) % (BOUNCE_MAX_US + 1);
+  bool now = level;
+  add_toggle(b, t, now);
+  for (uint32_t at = t + 20 + test_random(&seed) % 800; at < end; at += 20 + test_random(&seed) % 800) {
+    now = !now;
+    add_toggle(b, at, now);
+  }
+  if (now != level)
+    add_toggle(b, end, level);
+  return now != level ? end : b->toggles[b->toggle_count - 1].time_us;
+}
+
+// Segura o nivel por `hold` us, com pulsos espurios curtos no meio
+static void hold(button_t *b, uint32_t t, uint32_t hold_us, bool level) {
+  uint32_t end = t + hold_us;
+  for (uint32_t at = t + BUTTON_SETTLE_US + test_random(&seed) % 40000; at + 2 * BOUNCE_MAX_US < end;
+       at += BUTTON_SETTLE_US + test_random(&seed) % 40000) {
+    if (test_random(&seed) % 3)
+      continue;
+    uint32_t width = 1 + test_random(&seed) % BOUNCE_MAX_US;
+    add_toggle(b, at, !level);
+    add_toggle(b, at + width, level);
+    b->glitches++;
+  }
+}
+
+static void build(button_t *b, uint8_t pin, uint32_t start, int presses) {
+  b->pin = pin;
+  b->toggles = calloc(MAX_TOGGLES, sizeof(toggle_t));
+  b->presses = calloc(2 * presses, sizeof(press_t));
+  b->level = true;
+  uint32_t t = start;
+  hold(b, t, 50000, true);
+  t += 50000;
+  for (int i = 0; i < 2 * presses; ++i) {
+    // Pino com pull-up: aperto em nivel baixo
+    bool level = i & 1;
+    uint32_t stable = bounce(b, t, level);
+    b->presses[b->press_count++] = (press_t){ t, stable, level };
+    // Cliques rapidos e longas esperas
+    uint32_t hold_us = 2 * BUTTON_SETTLE_US + test_random(&seed) % (test_random(&seed) % 4 ? 60000 : 700000);
+    hold(b, stable, hold_us, level);
+    t = stable + hold_us;
+  }
+}
+
+static bool level_at(button_t *b, uint32_t t) {
+  while (b->next_toggle < b->toggle_count && (int32_t)(b->toggles[b->next_toggle].time_us - t) <= 0)
+    b->level = b->toggles[b->next_toggle++].level;
+  return b->level;
+}
+
+static void check_bounce(void) {
+  // Os dois botoes com formas de onda independentes, amostrados com
+  // BUTTON_SAMPLE_US a partir de uma fase qualquer, perto da volta do relogio
+  uint32_t start = 0xFFF00000u;
+  button_t buttons[2] = { { 0 } };
+  build(&buttons[0], 22, start, 2000);
+  build(&buttons[1], 5, start + 777, 2000);
+  CHECK(buttons[0].toggle_count < MAX_TOGGLES && buttons[1].toggle_count < MAX_TOGGLES,
+        "formas de onda longas demais");
+
+  debounce_t d;
+  debounce_init(&d, BUTTON_PINS, 0xFFFFFFFFu, BUTTON_SAMPLE_US, BUTTON_SETTLE_US);
+  uint32_t now = start + 123;
+  uint32_t latency_max = 0;
+  // Continua ate SETTLE_SAMPLES leituras depois da ultima transicao
+  for (int tail = 0; tail <= SETTLE_SAMPLES; now += BUTTON_SAMPLE_US) {
+    uint32_t raw = 0xFFFFFFFFu & ~BUTTON_PINS;
+    bool running = false;
+    for (int i = 0; i < 2; ++i) {
+      raw |= (uint32_t)level_at(&buttons[i], now) << buttons[i].pin;
+      running |= buttons[i].next_toggle < buttons[i].toggle_count;
+    }
+    tail = running ? 0 : tail + 1;
+    uint32_t changed = debounce_update(&d, raw, now);
+    CHECK(!(changed & ~BUTTON_PINS), "pino fora da mascara mudou: %08lx", (unsigned long)changed);
+    for (int i = 0; i < 2; ++i) {
+      button_t *b = &buttons[i];
+      if (!((changed >> b->pin) & 1))
+        continue;
+      if (b->next_press == b->press_count) {
+        CHECK(false, "pino %u: mudanca extra em %lu", b->pin, (unsigned long)now);
+        continue;
+      }
+      press_t *p = &b->presses[b->next_press++];
+      bool level = (d.state >> b->pin) & 1;
+      uint32_t latency = now - p->stable_us;
+      latency_max = latency > latency_max ? latency : latency_max;
+      CHECK(level == p->level, "pino %u: mudanca para %d em %lu, esperado %d", b->pin, level, (unsigned long)now,
+            p->level);
+      CHECK((int32_t)(now - p->start_us) >= (int32_t)((SETTLE_SAMPLES - 1) * BUTTON_SAMPLE_US) &&
+                latency <= SETTLE_SAMPLES * BUTTON_SAMPLE_US,
+            "pino %u: mudanca %d us depois do inicio e %d us depois de estavel", b->pin,
+            (int)(now - p->start_us), (int)latency);
+      CHECK((int32_t)(d.edge_us - p->start_us) >= 0 && (int32_t)(d.edge_us - p->stable_us) <= BUTTON_SAMPLE_US,
+            "pino %u: edge_us %lu fora de [%lu, %lu]", b->pin, (unsigned long)d.edge_us,
+            (unsigned long)p->start_us, (unsigned long)(p->stable_us + BUTTON_SAMPLE_US));
+    }
+  }
+  for (int i = 0; i < 2; ++i) {
+    CHECK(buttons[i].next_press == buttons[i].press_count, "pino %u: %d de %d mudancas", buttons[i].pin,
+          buttons[i].next_press, buttons[i].press_count);
+    printf("pino %u: %d mudancas, %d pulsos espurios ignorados\n", buttons[i].pin, buttons[i].press_count,
+           buttons[i].glitches);
+    free(buttons[i].toggles);
+    free(buttons[i].presses);
+  }
+  printf("atraso maximo depois do contato estavel: %lu us\n", (unsigned long)latency_max);
+}
+
+int main(void) {
+  check_settle_rounding();
+  for (uint8_t samples = 1; samples <= DEBOUNCE_MAX_SAMPLES; ++samples) {
+    check_against_model(0xFFFFFFFFu, samples);
+    check_against_model(test_random(&seed), samples);
+  }
+  check_bounce();
+  return TEST_RESULT();
+}
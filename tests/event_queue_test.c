@@ -0,0 +1,93 @@
+// Fila SPSC com produtor e consumidor em threads, como a IRQ e o laco
+// principal: cada evento aceito chega uma vez, em ordem e inteiro (campos
+// coerentes entre si), os recusados sao exatamente os contados em dropped,
+// e a fila nunca entrega um evento que nao foi escrito. Repetido com head e
+// tail perto de dar a volta nos 32 bits. Rajadas do produtor enchem a fila;
+// cedencias intercalam as threads mesmo numa maquina de uma CPU.
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include "test.h"
+#include "inc/event_queue.h"
+
+#define EVENTS 400000u
+
+static event_queue_t queue;
+static bool *accepted;       // Escrito so pelo produtor, lido depois do join
+static uint32_t *received;   // Escrito so pelo consumidor
+static atomic_bool done;
+
+// Campos derivados da sequencia: um evento rasgado nao os mantem coerentes
+static uint8_t event_pin(uint32_t seq) {
+  return (uint8_t)(seq * 7u >> 3);
+}
+
+static uint8_t event_edge(uint32_t seq) {
+  return (uint8_t)(seq ^ seq >> 8 ^ seq >> 16);
+}
+
+static void *producer(void *arg) {
+  (void)arg;
+  uint32_t seed = 0xE7E7u;
+  for (uint32_t seq = 0; seq < EVENTS; ++seq) {
+    accepted[seq] = event_queue_push(&queue, event_pin(seq), event_edge(seq), seq);
+    // Rajadas de tamanho aleatorio, as vezes maiores que a fila
+    if (test_random(&seed) % 24 == 0)
+      sched_yield();
+  }
+  atomic_store(&done, true);
+  return NULL;
+}
+
+static void stress(const char *name, uint32_t start) {
+  event_queue_init(&queue);
+  atomic_init(&queue.head, start);
+  atomic_init(&queue.tail, start);
+  atomic_init(&done, false);
+
+  pthread_t thread;
+  pthread_create(&thread, NULL, producer, NULL);
+  uint32_t count = 0, torn = 0, seed = 0xC0C0u;
+  bool finished = false;
+  while (!finished) {
+    // Depois do fim do produtor, um ultimo esvaziamento pega o que restou
+    finished = atomic_load(&done);
+    input_event_t e;
+    while (event_queue_pop(&queue, &e)) {
+      if (e.pin != event_pin(e.time_us) || e.edge != event_edge(e.time_us))
+        torn++;
+      if (count < EVENTS)
+        received[count] = e.time_us;
+      count++;
+      if (test_random(&seed) % 16 == 0)
+        sched_yield();
+    }
+    sched_yield();
+  }
+  pthread_join(thread, NULL);
+
+  uint32_t pushed = 0, out_of_order = 0;
+  for (uint32_t seq = 0; seq < EVENTS; ++seq)
+    if (accepted[seq] && (pushed >= count || received[pushed++] != seq))
+      out_of_order++;
+  uint32_t dropped = atomic_load(&queue.dropped);
+  printf("%s: %lu eventos aceitos, %lu perdidos com a fila cheia\n", name, (unsigned long)pushed,
+         (unsigned long)dropped);
+  CHECK(!torn, "%s: %lu eventos rasgados", name, (unsigned long)torn);
+  CHECK(count == pushed && !out_of_order, "%s: %lu recebidos para %lu aceitos, %lu fora de ordem", name,
+        (unsigned long)count, (unsigned long)pushed, (unsigned long)out_of_order);
+  CHECK(pushed + dropped == EVENTS, "%s: %lu aceitos + %lu perdidos", name, (unsigned long)pushed,
+        (unsigned long)dropped);
+  CHECK(dropped > 0 && pushed > EVENTS / 2, "%s: a fila nunca encheu ou quase tudo foi perdido", name);
+  CHECK_EQ(atomic_load(&queue.head) - start, pushed);
+}
+
+int main(void) {
+  accepted = calloc(EVENTS, sizeof(*accepted));
+  received = calloc(EVENTS, sizeof(*received));
+  stress("do zero", 0);
+  stress("perto da volta", 0u - 1000);
+  free(accepted);
+  free(received);
+  return TEST_RESULT();
+}
@@ -0,0 +1,266 @@
+// Reconhecedor de gestos contra uma especificacao escrita de forma direta
+// sobre a sequencia de pressionar/soltar, com as configuracoes do firmware:
+// segurar long_press_us - 1 e um clique e long_press_us um long press; um
+// segundo pressionar a double_click_us - 1 do soltar e um duplo clique e a
+// double_click_us sao dois cliques; repeticoes a cada repeat_us; cada gesto
+// sai exatamente no instante do prazo, inclusive na volta do relogio.
+// Depois a cadeia do firmware (debounce, fila de eventos, gestos) sobre o
+// nivel do contato: as bordas chegam atrasadas pelo tempo de acomodacao e
+// os limites tem de continuar valendo para o tempo do contato.
+#include <stdlib.h>
+#include "test.h"
+#include "inc/app_config.h"
+#include "inc/debounce.h"
+#include "inc/event_queue.h"
+
+#define MAX_EVENTS 3000
+#define MAX_GESTURES 8000
+
+typedef struct {
+  gesture_t gesture;
+  uint32_t time_us;
+} emitted_t;
+
+static const char *const names[] = { "nenhum", "clique", "duplo clique", "long press", "repeticao" };
+static uint32_t seed = 0x6E57u;
+
+// ======= Especificacao =======
+// t[0] pressiona, t[1] solta, t[2] pressiona...; devolve os gestos e seus instantes
+static int reference(const gesture_config_t *c, const uint32_t *t, int n, emitted_t *out) {
+  int count = 0;
+  for (int i = 0; i < n;) {
+    uint32_t press = t[i], release = t[i + 1];
+    if (release - press >= c->long_press_us) {
+      out[count++] = (emitted_t){ GESTURE_LONG_PRESS, press + c->long_press_us };
+      // Repeticoes ate o soltar, inclusive
+      if (c->repeat_us)
+        for (uint32_t at = press + c->long_press_us + c->repeat_us; (int32_t)(release - at) >= 0; at += c->repeat_us)
+          out[count++] = (emitted_t){ GESTURE_REPEAT, at };
+      i += 2;
+    } else if (!c->double_click_us) {
+      out[count++] = (emitted_t){ GESTURE_CLICK, release };
+      i += 2;
+    } else if (i + 2 < n && t[i + 2] - release < c->double_click_us) {
+      // O segundo pressionar so termina ao soltar, seja qual for a duracao
+      out[count++] = (emitted_t){ GESTURE_DOUBLE_CLICK, t[i + 3] };
+      i += 4;
+    } else {
+      out[count++] = (emitted_t){ GESTURE_CLICK, release + c->double_click_us };
+      i += 2;
+    }
+  }
+  return count;
+}
+
+static int compare(const char *what, const emitted_t *got, int got_count, const emitted_t *want, int want_count,
+                   uint32_t slack_us) {
+  int i = 0;
+  for (; i < got_count && i < want_count; ++i)
+    if (got[i].gesture != want[i].gesture || got[i].time_us - want[i].time_us > slack_us) {
+      CHECK(false, "%s, gesto %d: %s em %lu, esperado %s em %lu", what, i, names[got[i].gesture],
+            (unsigned long)got[i].time_us, names[want[i].gesture], (unsigned long)want[i].time_us);
+      return i;
+    }
+  CHECK(got_count == want_count, "%s: %d gestos, esperados %d (primeiro a mais ou a menos: %s)", what, got_count,
+        want_count, i < got_count ? names[got[i].gesture] : i < want_count ? names[want[i].gesture] : "-");
+  return i;
+}
+
+// Duracao perto de um dos limites da configuracao (a 0, 1 ou 2 us) ou qualquer
+static uint32_t pick_duration(const gesture_config_t *c, bool pressed) {
+  uint32_t r = test_random(&seed);
+  uint32_t limit;
+  switch (r % 4) {
+    case 0: limit = c->long_press_us; break;
+    case 1: limit = c->double_click_us; break;
+    case 2: limit = c->long_press_us + (1 + (r >> 8) % 3) * c->repeat_us; break;
+    default: return 1 + test_random(&seed) % (pressed ? 2 * c->long_press_us : 2 * c->double_click_us + 1);
+  }
+  return limit > 2 ? limit + (r >> 4) % 5 - 2 : 1 + (r >> 4) % 5;
+}
+
+// Duracao a menos de `margin` de um limite de tempo
+static bool near_limit(const gesture_config_t *c, uint32_t d, uint32_t margin) {
+  if ((uint32_t)abs((int32_t)(d - c->long_press_us)) < margin ||
+      (uint32_t)abs((int32_t)(d - c->double_click_us)) < margin)
+    return true;
+  if (!c->repeat_us || d < c->long_press_us)
+    return false;
+  uint32_t phase = (d - c->long_press_us) % c->repeat_us;
+  return phase < margin || c->repeat_us - phase < margin;
+}
+
+// ======= Reconhecedor isolado =======
+typedef struct {
+  uint32_t offset;
+  int8_t pressed;   // -1: gesture_update
+} call_t;
+
+static int compare_calls(const void *a, const void *b) {
+  const call_t *x = a, *y = b;
+  if (x->offset != y->offset)
+    return x->offset < y->offset ? -1 : 1;
+  // No mesmo instante o evento vem antes da verificacao de prazos
+  return (y->pressed >= 0) - (x->pressed >= 0);
+}
+
+static void check_recognizer(const char *name, const gesture_config_t *c) {
+  static uint32_t t[MAX_EVENTS];
+  static emitted_t want[MAX_GESTURES], got[MAX_GESTURES];
+  uint32_t start = 0u - 600000000u;    // A volta do relogio cai no meio
+
+  uint32_t offset = 1000;
+  for (int i = 0; i < MAX_EVENTS; ++i) {
+    t[i] = start + offset;
+    offset += pick_duration(c, !(i & 1));
+  }
+  CHECK(offset < 1u << 31, "%s: roteiro longo demais para a ordem das chamadas", name);
+  int want_count = reference(c, t, MAX_EVENTS, want);
+
+  // Chamadas: os eventos, uma verificacao por milissegundo e verificacoes
+  // 1 us antes e em cada prazo possivel
+  uint32_t end = offset + 2 * (c->long_press_us + c->double_click_us);
+  call_t *calls = calloc(MAX_EVENTS * 9 + end / 1000 + 1, sizeof(call_t));
+  int n = 0;
+  for (int i = 0; i < MAX_EVENTS; ++i) {
+    uint32_t at = t[i] - start;
+    calls[n++] = (call_t){ at, !(i & 1) };
+    uint32_t deadlines[] = {
+      at + (i & 1 ? c->double_click_us : c->long_press_us),
+      at + c->long_press_us + c->repeat_us,
+      at + c->long_press_us + 2 * c->repeat_us,
+      at + c->long_press_us + 3 * c->repeat_us,
+    };
+    for (size_t k = 0; k < count_of(deadlines); ++k) {
+      calls[n++] = (call_t){ deadlines[k] - 1, -1 };
+      calls[n++] = (call_t){ deadlines[k], -1 };
+    }
+  }
+  for (uint32_t at = 0; at < end; at += 1000)
+    calls[n++] = (call_t){ at, -1 };
+  qsort(calls, n, sizeof(call_t), compare_calls);
+
+  gesture_button_t b;
+  gesture_init(&b, c);
+  int got_count = 0;
+  for (int i = 0; i < n && got_count < MAX_GESTURES; ++i) {
+    uint32_t now = start + calls[i].offset;
+    gesture_t g = calls[i].pressed < 0 ? gesture_update(&b, now) : gesture_event(&b, calls[i].pressed, now);
+    if (g != GESTURE_NONE)
+      got[got_count++] = (emitted_t){ g, now };
+  }
+  free(calls);
+
+  int counts[5] = { 0 };
+  for (int i = 0; i < want_count; ++i)
+    counts[want[i].gesture]++;
+  printf("%s: %d cliques, %d duplos, %d long press, %d repeticoes\n", name, counts[GESTURE_CLICK],
+         counts[GESTURE_DOUBLE_CLICK], counts[GESTURE_LONG_PRESS], counts[GESTURE_REPEAT]);
+  compare(name, got, got_count, want, want_count, 0);
+}
+
+static void check_boundaries(void) {
+  // Os limites de forma explicita, para a leitura do teste
+  static const gesture_config_t c = { .double_click_us = 300, .long_press_us = 600, .repeat_us = 400 };
+  static const struct {
+    uint32_t t[4];
+    int n;
+    gesture_t first;
+    uint32_t at;
+  } cases[] = {
+    { { 0, 599 }, 2, GESTURE_CLICK, 899 },                  // Segurou 1 us a menos que o long press
+    { { 0, 600 }, 2, GESTURE_LONG_PRESS, 600 },             // Soltou no instante do long press
+    { { 0, 100, 399, 450 }, 4, GESTURE_DOUBLE_CLICK, 450 }, // Segundo aperto 1 us antes do fim da janela
+    { { 0, 100, 400, 450 }, 4, GESTURE_CLICK, 400 },        // Segundo aperto no fim da janela
+    { { 0, 100, 200, 5000 }, 4, GESTURE_DOUBLE_CLICK, 5000 },  // Segundo aperto longo ainda e duplo
+  };
+  for (size_t i = 0; i < count_of(cases); ++i) {
+    gesture_button_t b;
+    gesture_init(&b, &c);
+    gesture_t first = GESTURE_NONE;
+    uint32_t at = 0;
+    for (uint32_t now = 0, e = 0; now < 6000 && first == GESTURE_NONE; ++now) {
+      gesture_t g = GESTURE_NONE;
+      if (e < (uint32_t)cases[i].n && cases[i].t[e] == now)
+        g = gesture_event(&b, !(e++ & 1), now);
+      if (g == GESTURE_NONE)
+        g = gesture_update(&b, now);
+      if (g != GESTURE_NONE)
+        first = g, at = now;
+    }
+    CHECK(first == cases[i].first && at == cases[i].at, "caso %zu: %s em %lu, esperado %s em %lu", i,
+          names[first], (unsigned long)at, names[cases[i].first], (unsigned long)cases[i].at);
+  }
+}
+
+// ======= Cadeia do firmware =======
+// Como button_timer_callback e handle_input_events em AtividadeADC.c: o
+// debounce amostra o pino a cada BUTTON_SAMPLE_US e enfileira as bordas com
+// edge_us; o laco de entrada, defasado do timer, esvazia a fila e verifica
+// os prazos no relogio de debounce_settled_us
+#define PIN 5
+
+static void check_pipeline(const char *name, const gesture_config_t *c) {
+  // Limites do contato a pelo menos uma amostra e meia de distancia, com
+  // borda a qualquer instante entre amostras: o tempo medido pelas bordas
+  // difere do contato em menos de uma amostra
+  static uint32_t t[MAX_EVENTS];
+  static emitted_t want[MAX_GESTURES], got[MAX_GESTURES];
+  uint32_t margin = BUTTON_SAMPLE_US * 3 / 2;
+  uint32_t start = 0u - 300000000u;
+  uint32_t offset = 10000;
+  for (int i = 0; i < MAX_EVENTS; ++i) {
+    t[i] = start + offset;
+    uint32_t d;
+    do {
+      d = pick_duration(c, !(i & 1)) + test_random(&seed) % (4 * margin) - 2 * margin;
+    } while ((int32_t)d < (int32_t)(BUTTON_SETTLE_US + margin) || near_limit(c, d, margin));
+    offset += d;
+  }
+  int want_count = reference(c, t, MAX_EVENTS, want);
+
+  debounce_t d;
+  event_queue_t queue;
+  gesture_button_t b;
+  debounce_init(&d, 1u << PIN, 1u << PIN, BUTTON_SAMPLE_US, BUTTON_SETTLE_US);
+  event_queue_init(&queue);
+  gesture_init(&b, c);
+  int next = 0, got_count = 0;
+  bool level = true;
+  uint32_t end = offset + 2 * (c->long_press_us + c->double_click_us);
+  for (uint32_t elapsed = 137; elapsed < end; elapsed += BUTTON_SAMPLE_US) {
+    uint32_t now = start + elapsed;
+    // Timer do debounce
+    while (next < MAX_EVENTS && (int32_t)(now - t[next]) >= 0)
+      level = next++ & 1;
+    if (debounce_update(&d, level << PIN, now))
+      event_queue_push(&queue, PIN, (d.state >> PIN) & 1 ? HAL_EDGE_RISE : HAL_EDGE_FALL, d.edge_us);
+
+    // Laco de entrada, meia amostra depois
+    uint32_t settled = debounce_settled_us(&d, now + BUTTON_SAMPLE_US / 2);
+    input_event_t e;
+    while (event_queue_pop(&queue, &e)) {
+      gesture_t g = gesture_event(&b, e.edge == HAL_EDGE_FALL, e.time_us);
+      if (g != GESTURE_NONE && got_count < MAX_GESTURES)
+        got[got_count++] = (emitted_t){ g, e.time_us };
+    }
+    gesture_t g = gesture_update(&b, settled);
+    if (g != GESTURE_NONE && got_count < MAX_GESTURES)
+      got[got_count++] = (emitted_t){ g, settled };
+  }
+  CHECK_EQ(queue.dropped, 0);
+  // O instante de cada gesto no relogio do contato: ate uma amostra depois
+  // do prazo, mais a defasagem do laco de entrada
+  compare(name, got, got_count, want, want_count, BUTTON_SAMPLE_US + BUTTON_SAMPLE_US / 2);
+}
+
+int main(void) {
+  check_boundaries();
+  check_recognizer("SW_GESTURES", &SW_GESTURES);
+  check_recognizer("BUTTON_A_GESTURES", &BUTTON_A_GESTURES);
+  static const gesture_config_t immediate = { .double_click_us = 0, .long_press_us = 600000, .repeat_us = 0 };
+  check_recognizer("sem duplo clique", &immediate);
+  check_pipeline("SW_GESTURES pelo debounce", &SW_GESTURES);
+  check_pipeline("BUTTON_A_GESTURES pelo debounce", &BUTTON_A_GESTURES);
+  return TEST_RESULT();
+}
@@ -0,0 +1,56 @@
+#include "hardware/interp.h"
+
+// Modelo dos interpoladores do SIO conforme a secao 2.3.1.6 do datasheet do
+// RP2040, so para os testes do host
+
+interp_hw_t interp_model_hw[2];
+
+// Acumulador da lane depois do shift e da mascara, com extensao de sinal
+static uint32_t interp_model_shift_mask(const interp_hw_t *interp, uint lane) {
+  uint32_t ctrl = interp->ctrl[lane];
+  uint32_t input = interp->accum[ctrl & SIO_INTERP0_CTRL_LANE0_CROSS_INPUT_BITS ? 1 - lane : lane];
+  uint shift = (ctrl & SIO_INTERP0_CTRL_LANE0_SHIFT_BITS) >> SIO_INTERP0_CTRL_LANE0_SHIFT_LSB;
+  uint lsb = (ctrl & SIO_INTERP0_CTRL_LANE0_MASK_LSB_BITS) >> SIO_INTERP0_CTRL_LANE0_MASK_LSB_LSB;
+  uint msb = (ctrl & SIO_INTERP0_CTRL_LANE0_MASK_MSB_BITS) >> SIO_INTERP0_CTRL_LANE0_MASK_MSB_LSB;
+  uint32_t mask = (msb == 31 ? 0xFFFFFFFFu : (1u << (msb + 1)) - 1) & ~((1u << lsb) - 1);
+  uint32_t value = (input >> shift) & mask;
+  if ((ctrl & SIO_INTERP0_CTRL_LANE0_SIGNED_BITS) && msb < 31 && (value >> msb) & 1)
+    value |= ~((1u << (msb + 1)) - 1);
+  return value;
+}
+
+uint32_t interp_peek_lane_result(interp_hw_t *interp, uint lane) {
+  uint32_t ctrl0 = interp->ctrl[0];
+  bool blend = interp == interp0 && (ctrl0 & SIO_INTERP0_CTRL_LANE0_BLEND_BITS);
+  bool clamp = interp == interp1 && (ctrl0 & SIO_INTERP1_CTRL_LANE0_CLAMP_BITS);
+  uint32_t sm0 = interp_model_shift_mask(interp, 0);
+  uint32_t sm1 = interp_model_shift_mask(interp, 1);
+
+  if (lane == 2)
+    return interp->base[2] + sm0 + (blend ? 0 : sm1);
+
+  if (blend) {
+    // Lane 1: BASE0 + (BASE1 - BASE0) * alpha / 256, alpha = 8 bits baixos da
+    // lane 1, com sinal conforme SIGNED da lane 1; lane 0 sem BASE0
+    if (lane == 0)
+      return sm0;
+    uint32_t alpha = sm1 & 0xFF;
+    if (interp->ctrl[1] & SIO_INTERP0_CTRL_LANE0_SIGNED_BITS)
+      return interp->base[0] + (uint32_t)(int32_t)(((int64_t)(int32_t)interp->base[1] -
+                                                    (int32_t)interp->base[0]) * alpha >> 8);
+    return interp->base[0] + (uint32_t)(((int64_t)interp->base[1] - interp->base[0]) * alpha >> 8);
+  }
+
+  if (clamp && lane == 0) {
+    // Lane 0 sem BASE0, limitada a BASE0..BASE1 (comparacao com sinal se SIGNED)
+    if (ctrl0 & SIO_INTERP0_CTRL_LANE0_SIGNED_BITS) {
+      int32_t v = (int32_t)sm0, lo = (int32_t)interp->base[0], hi = (int32_t)interp->base[1];
+      return (uint32_t)(v < lo ? lo : v > hi ? hi : v);
+    }
+    return sm0 < interp->base[0] ? interp->base[0] : sm0 > interp->base[1] ? interp->base[1] : sm0;
+  }
+
+  uint32_t ctrl = interp->ctrl[lane];
+  uint32_t raw = interp->accum[ctrl & SIO_INTERP0_CTRL_LANE0_CROSS_INPUT_BITS ? 1 - lane : lane];
+  return interp->base[lane] + (ctrl & SIO_INTERP0_CTRL_LANE0_ADD_RAW_BITS ? raw : (lane ? sm1 : sm0));
+}
@@ -0,0 +1,72 @@
+# Regressão ponta a ponta: reproduz um trace no AtividadeADC_host (relógio
+# virtual, painel emulado) e compara frames.csv (tráfego e hash da GDDRAM de
+# cada quadro) e pwm.csv (linha do tempo dos LEDs) com as referências.
+#   cmake -DREPLAY=<AtividadeADC_host> -DTRACE=<trace> -DGOLDEN=<pasta>
+#         -DWORK=<pasta temporária> [-DUPDATE=ON] -P replay_check.cmake
+# Com UPDATE=ON regrava as referências em vez de comparar (alvo
+# replay_golden_update).
+foreach(var REPLAY TRACE GOLDEN WORK)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "replay_check: falta -D${var}=...")
+    endif()
+endforeach()
+
+file(REMOVE_RECURSE ${WORK})
+file(MAKE_DIRECTORY ${WORK})
+execute_process(COMMAND ${REPLAY} ${TRACE} ${WORK}
+    RESULT_VARIABLE result OUTPUT_VARIABLE output ERROR_VARIABLE errors)
+message(STATUS "${TRACE}\n${output}${errors}")
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "replay_check: ${REPLAY} terminou com ${result}")
+endif()
+
+set(failed FALSE)
+foreach(name frames.csv pwm.csv)
+    if(UPDATE)
+        configure_file(${WORK}/${name} ${GOLDEN}/${name} COPYONLY)
+        message(STATUS "regravado ${GOLDEN}/${name}")
+        continue()
+    endif()
+    if(NOT EXISTS ${GOLDEN}/${name})
+        message(SEND_ERROR "replay_check: falta a referência ${GOLDEN}/${name}")
+        set(failed TRUE)
+        continue()
+    endif()
+
+    # Primeira linha diferente, para apontar o quadro ou o instante
+    file(STRINGS ${GOLDEN}/${name} expected)
+    file(STRINGS ${WORK}/${name} actual)
+    list(LENGTH expected expected_count)
+    list(LENGTH actual actual_count)
+    set(count ${expected_count})
+    if(actual_count LESS count)
+        set(count ${actual_count})
+    endif()
+    set(line 0)
+    while(line LESS count)
+        list(GET expected ${line} want)
+        list(GET actual ${line} got)
+        if(NOT got STREQUAL want)
+            break()
+        endif()
+        math(EXPR line "${line} + 1")
+    endwhile()
+    if(line LESS count OR NOT actual_count EQUAL expected_count)
+        math(EXPR line_number "${line} + 1")
+        set(want "(fim do arquivo)")
+        set(got "(fim do arquivo)")
+        if(line LESS expected_count)
+            list(GET expected ${line} want)
+        endif()
+        if(line LESS actual_count)
+            list(GET actual ${line} got)
+        endif()
+        message(SEND_ERROR "replay_check: ${name} difere na linha ${line_number}\n"
+            "  esperado: ${want}\n  obtido:   ${got}\n"
+            "(${actual_count} linhas, esperadas ${expected_count}; saída em ${WORK})")
+        set(failed TRUE)
+    endif()
+endforeach()
+if(failed)
+    message(FATAL_ERROR "replay_check: ${TRACE} diverge de ${GOLDEN}")
+endif()
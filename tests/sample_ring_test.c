@@ -0,0 +1,169 @@
+// Anel de amostras com uma fonte sintetica no lugar do DMA: o consumidor le
+// os blocos completos em ordem e so blocos inteiros; atrasado mais de
+// SAMPLE_RING_READABLE blocos, pula os mais antigos e os conta em overruns;
+// se o produtor alcancar o bloco durante a copia, o bloco e descartado e
+// contado. Para o produtor avancar no meio da copia, memcpy e embrulhado
+// (-Wl,--wrap=memcpy) e o gancho faz o papel da IRQ do DMA.
+#include <string.h>
+#include "test.h"
+#include "inc/hal.h"
+#include "inc/sample_ring.h"
+
+// Mesmo limite de sample_ring.c
+#define SAMPLE_RING_READABLE (SAMPLE_RING_BLOCKS - 2)
+
+static sample_ring_t ring;
+static uint32_t produced;      // Blocos escritos pela fonte (written, sem volta)
+static int commits_in_copy;    // Blocos que o gancho completa na proxima copia
+static uint32_t seed = 0x5A4Du;
+
+// Amostra i do bloco n: y identifica o bloco, x a posicao
+static joystick_sample_t sample_of(uint32_t n, int i) {
+  return (joystick_sample_t){ (uint16_t)(n * SAMPLE_RING_BLOCK_SAMPLES + i), (uint16_t)n };
+}
+
+// O DMA escreve o bloco `written`; first..last e o trecho ja escrito
+static void fill(uint32_t n, int first, int last) {
+  joystick_sample_t *block = sample_ring_block(&ring, n);
+  for (int i = first; i < last; ++i)
+    block[i] = sample_of(n, i);
+}
+
+static void produce(int blocks) {
+  for (int i = 0; i < blocks; ++i) {
+    fill(produced, 0, SAMPLE_RING_BLOCK_SAMPLES);
+    sample_ring_commit(&ring);
+    produced++;
+  }
+}
+
+void *__real_memcpy(void *dst, const void *src, size_t len);
+
+// A IRQ chega no meio da copia: completa blocos e comeca a escrever o
+// seguinte, que o canal encadeado ja tinha armado
+void *__wrap_memcpy(void *dst, const void *src, size_t len) {
+  if (!commits_in_copy)
+    return __real_memcpy(dst, src, len);
+  __real_memcpy(dst, src, len / 2);
+  produce(commits_in_copy);
+  commits_in_copy = 0;
+  fill(produced, 0, SAMPLE_RING_BLOCK_SAMPLES / 2);
+  return __real_memcpy((char *)dst + len / 2, (const char *)src + len / 2, len - len / 2);
+}
+
+// Confere os blocos lidos: inteiros e em ordem a partir de *next (pulando os
+// descartados); devolve os blocos pulados
+static uint32_t check_blocks(const char *what, const joystick_sample_t *out, size_t count, uint32_t *next) {
+  uint32_t skipped = 0;
+  CHECK(count % SAMPLE_RING_BLOCK_SAMPLES == 0, "%s: %lu amostras, nao um numero de blocos", what,
+        (unsigned long)count);
+  for (size_t b = 0; b < count / SAMPLE_RING_BLOCK_SAMPLES; ++b) {
+    const joystick_sample_t *block = &out[b * SAMPLE_RING_BLOCK_SAMPLES];
+    uint16_t n = block[0].y;
+    CHECK((int16_t)(n - (uint16_t)*next) >= 0, "%s: bloco %u depois do %lu", what, n, (unsigned long)*next);
+    skipped += (uint16_t)(n - (uint16_t)*next);
+    for (int i = 0; i < SAMPLE_RING_BLOCK_SAMPLES; ++i) {
+      joystick_sample_t want = sample_of(n, i);
+      if (block[i].x != want.x || block[i].y != want.y) {
+        CHECK(false, "%s: bloco %u rasgado na amostra %d", what, n, i);
+        break;
+      }
+    }
+    *next = n + 1;
+  }
+  return skipped;
+}
+
+static void reset(void) {
+  sample_ring_init(&ring);
+  produced = 0;
+}
+
+static void check_in_order(void) {
+  static joystick_sample_t out[SAMPLE_RING_BLOCKS * SAMPLE_RING_BLOCK_SAMPLES];
+  joystick_sample_t latest;
+  reset();
+  CHECK(!sample_ring_latest(&ring, &latest), "amostra antes do primeiro bloco");
+  CHECK_EQ(sample_ring_read(&ring, out, count_of(out)), 0);
+
+  // Leituras de tamanhos variados (menos de um bloco nao le nada), com a
+  // fonte sempre dentro do limite
+  uint32_t next = 0;
+  for (int round = 0; round < 20000 && !test_failures; ++round) {
+    uint32_t room = SAMPLE_RING_READABLE - (produced - ring.read);
+    produce(test_random(&seed) % (room < 3 ? room + 1 : 4));
+    uint32_t available = produced - ring.read;
+    size_t max = test_random(&seed) % (3 * SAMPLE_RING_BLOCK_SAMPLES + 8);
+    size_t blocks = max / SAMPLE_RING_BLOCK_SAMPLES < available ? max / SAMPLE_RING_BLOCK_SAMPLES : available;
+    size_t count = sample_ring_read(&ring, out, max);
+    CHECK(count == blocks * SAMPLE_RING_BLOCK_SAMPLES, "%lu blocos disponiveis e espaco para %lu amostras: leu %lu",
+          (unsigned long)available, (unsigned long)max, (unsigned long)count);
+    CHECK_EQ(check_blocks("em ordem", out, count, &next), 0);
+  }
+  CHECK_EQ(ring.overruns, 0);
+  CHECK(sample_ring_latest(&ring, &latest) && latest.y == (uint16_t)(produced - 1) &&
+            latest.x == sample_of(produced - 1, SAMPLE_RING_BLOCK_SAMPLES - 1).x,
+        "ultima amostra do bloco %u, esperado %lu", latest.y, (unsigned long)(produced - 1));
+}
+
+static void check_overrun(void) {
+  // Consumidor atrasado: so os ultimos SAMPLE_RING_READABLE blocos sao lidos
+  static joystick_sample_t out[SAMPLE_RING_BLOCKS * SAMPLE_RING_BLOCK_SAMPLES];
+  for (int lag = SAMPLE_RING_READABLE - 1; lag <= 3 * SAMPLE_RING_BLOCKS; ++lag) {
+    reset();
+    produce(5);
+    uint32_t next = 0;
+    check_blocks("atraso", out, sample_ring_read(&ring, out, count_of(out)), &next);
+    produce(lag);
+    size_t count = sample_ring_read(&ring, out, count_of(out));
+    uint32_t lost = lag > SAMPLE_RING_READABLE ? lag - SAMPLE_RING_READABLE : 0;
+    CHECK(count == (lag - lost) * SAMPLE_RING_BLOCK_SAMPLES && ring.overruns == lost,
+          "atraso de %d blocos: %lu amostras e %lu overruns, esperados %lu blocos e %lu", lag,
+          (unsigned long)count, (unsigned long)ring.overruns, (unsigned long)(lag - lost), (unsigned long)lost);
+    CHECK_EQ(check_blocks("atraso", out, count, &next), lost);
+    CHECK_EQ(next, produced);
+  }
+}
+
+static void check_commit_during_copy(void) {
+  // Com o bloco lido a `lag` blocos do produtor, a IRQ completa `commits`
+  // blocos durante a copia. O bloco e descartado quando o DMA passa a
+  // escrever no mesmo lugar: written - read > SAMPLE_RING_READABLE + 1
+  static joystick_sample_t out[SAMPLE_RING_BLOCK_SAMPLES];
+  for (int lag = 1; lag <= SAMPLE_RING_READABLE; ++lag)
+    for (int commits = 1; commits <= 4; ++commits) {
+      // Blocos ja lidos antes, para o anel dar a volta
+      reset();
+      produce(3);
+      uint32_t next = 0;
+      while (ring.read != produced)
+        check_blocks("antes da copia", out, sample_ring_read(&ring, out, count_of(out)), &next);
+      // Le ate o bloco que fica a `lag` do produtor
+      produce(SAMPLE_RING_READABLE);
+      for (int i = 0; i < SAMPLE_RING_READABLE - lag; ++i)
+        check_blocks("antes da copia", out, sample_ring_read(&ring, out, count_of(out)), &next);
+      uint32_t overruns = ring.overruns, target = ring.read;
+      commits_in_copy = commits;
+      size_t count = sample_ring_read(&ring, out, count_of(out));
+      // Descartado, a leitura segue no bloco seguinte, ou nos ultimos
+      // SAMPLE_RING_READABLE se a fonte tiver passado do limite
+      bool drop = lag + commits > SAMPLE_RING_READABLE + 1;
+      uint32_t first = target;
+      if (drop)
+        first = produced - (target + 1) > SAMPLE_RING_READABLE ? produced - SAMPLE_RING_READABLE : target + 1;
+      CHECK(ring.overruns - overruns == (drop ? first - target : 0),
+            "atraso %d, %d blocos na copia: %lu blocos perdidos, esperados %lu", lag, commits,
+            (unsigned long)(ring.overruns - overruns), (unsigned long)(first - target));
+      CHECK(count == SAMPLE_RING_BLOCK_SAMPLES && out[0].y == (uint16_t)first,
+            "atraso %d, %d blocos na copia: leu o bloco %u, esperado %lu", lag, commits, out[0].y,
+            (unsigned long)first);
+      check_blocks("copia", out, count, &next);
+    }
+}
+
+int main(void) {
+  check_in_order();
+  check_overrun();
+  check_commit_during_copy();
+  return TEST_RESULT();
+}
@@ -0,0 +1,151 @@
+// Escalonador no relogio virtual do host, com o tick vindo de um timer da
+// HAL (scheduler_start/wait/poll, como no firmware). Tarefas que gastam
+// tempo avancam o relogio, e os ticks que vencem durante a execucao chegam
+// como a IRQ chegaria. Para cada execucao: a tarefa roda no primeiro tick
+// processado a partir do prazo, nunca antes; os prazos ficam na grade de
+// periodo e fase mesmo depois de atrasos; execucoes + overruns = prazos
+// vencidos; jitter e duracao registrados batem com o relogio. Com carga
+// leve o jitter e zero, inclusive quando o contador de ticks e o relogio de
+// 32 bits dao a volta.
+#include "test.h"
+#include "inc/hal.h"
+#include "inc/scheduler.h"
+
+#define TICK_US 1000
+
+typedef struct {
+  const char *name;
+  uint32_t period, phase;
+  uint32_t busy_max_us;    // Duracao aleatoria de 0 a busy_max_us (0: instantanea)
+  uint32_t first;          // Primeiro prazo
+  scheduler_task_t *task;
+  uint32_t runs, jitter_max, duration_max;
+  uint64_t jitter_sum;
+} probe_t;
+
+static scheduler_t sched;
+static uint32_t last_polled;  // Tick processado antes do atual
+static uint32_t seed = 0x5C4Eu;
+
+static void probe_run(void *user) {
+  probe_t *p = user;
+  uint32_t tick = sched.done, now = hal_time_us();
+  uint32_t since = tick - p->first;
+  CHECK((int32_t)since >= 0, "%s rodou no tick %lu, antes do primeiro prazo %lu", p->name, (unsigned long)tick,
+        (unsigned long)p->first);
+  // Prazo desta execucao: o ultimo da grade ate o tick atual; o tick
+  // processado anterior tem de ser anterior a ele
+  uint32_t due = tick - since % p->period;
+  CHECK((int32_t)(last_polled - due) < 0, "%s devida no tick %lu so rodou no %lu (ja processado o %lu)", p->name,
+        (unsigned long)due, (unsigned long)tick, (unsigned long)last_polled);
+  CHECK(p->task->next == due + p->period, "%s no tick %lu: proximo prazo %lu fora da grade (%lu)", p->name,
+        (unsigned long)tick, (unsigned long)p->task->next, (unsigned long)(due + p->period));
+
+  uint32_t jitter = now - (sched.start_us + tick * sched.tick_us);
+  p->runs++;
+  p->jitter_sum += jitter;
+  if (jitter > p->jitter_max)
+    p->jitter_max = jitter;
+  if (p->busy_max_us) {
+    uint32_t busy = test_random(&seed) % (p->busy_max_us + 1);
+    hal_host_advance_us(busy);
+    if (busy > p->duration_max)
+      p->duration_max = busy;
+  }
+}
+
+// Roda ate `ticks` ticks depois do inicio e confere as estatisticas
+static void run(const char *scenario, probe_t *probes, int count, uint32_t base, uint32_t ticks) {
+  sched.done = base;
+  for (int i = 0; i < count; ++i) {
+    probe_t *p = &probes[i];
+    p->task = scheduler_add(&sched, probe_run, p, p->period, p->phase);
+    p->first = base + 1 + p->phase;
+    CHECK(p->task, "%s: %s nao foi adicionada", scenario, p->name);
+  }
+  scheduler_start(&sched);
+  last_polled = base;
+  uint32_t polls = 0;
+  while (sched.done - base < ticks) {
+    scheduler_wait(&sched);
+    if (scheduler_poll(&sched))
+      polls++;
+    last_polled = sched.done;
+  }
+  scheduler_stop(&sched);
+
+  uint32_t end = sched.done;
+  CHECK_EQ(sched.late_ticks, end - base - polls);
+  for (int i = 0; i < count; ++i) {
+    probe_t *p = &probes[i];
+    scheduler_task_t *t = p->task;
+    uint32_t deadlines = (int32_t)(end - p->first) < 0 ? 0 : (end - p->first) / p->period + 1;
+    CHECK(t->runs == p->runs && t->runs + t->overruns == deadlines,
+          "%s, %s: %lu execucoes (%lu observadas) e %lu overruns para %lu prazos", scenario, p->name,
+          (unsigned long)t->runs, (unsigned long)p->runs, (unsigned long)t->overruns, (unsigned long)deadlines);
+    CHECK(t->jitter_max == p->jitter_max && t->jitter_sum == p->jitter_sum,
+          "%s, %s: jitter maximo %lu, observado %lu", scenario, p->name, (unsigned long)t->jitter_max,
+          (unsigned long)p->jitter_max);
+    CHECK(t->duration_max == p->duration_max, "%s, %s: duracao maxima %lu, observada %lu", scenario, p->name,
+          (unsigned long)t->duration_max, (unsigned long)p->duration_max);
+  }
+}
+
+static void check_light_load(void) {
+  // Tarefas instantaneas: todas no horario, sem overruns nem ticks perdidos,
+  // e as duas de mesmo periodo espalhadas pela fase
+  probe_t probes[] = {
+    { "entrada", 1, 0, 0 },
+    { "display", 20, 0, 0 },
+    { "display+10", 20, 10, 0 },
+    { "lenta", 1000, 3, 0 },
+  };
+  scheduler_init(&sched, TICK_US, NULL);
+  run("carga leve", probes, count_of(probes), 0, 20000);
+  CHECK_EQ(sched.late_ticks, 0);
+  for (size_t i = 0; i < count_of(probes); ++i) {
+    CHECK(probes[i].jitter_max == 0 && probes[i].task->overruns == 0, "carga leve, %s: jitter %lu, %lu overruns",
+          probes[i].name, (unsigned long)probes[i].jitter_max, (unsigned long)probes[i].task->overruns);
+  }
+  CHECK_EQ(probes[0].runs, 20000);
+  CHECK_EQ(probes[1].runs, 1000);
+}
+
+static void check_overload(void) {
+  // Duracoes aleatorias de ate 3,5 ticks: ticks sao pulados, as tarefas
+  // acumulam overruns e jitter, mas continuam na grade de prazos
+  probe_t probes[] = {
+    { "entrada", 1, 0, 300 },
+    { "display", 20, 0, 3500 },
+    { "poll", 1, 0, 0 },
+    { "relatorio", 7, 5, 1200 },
+  };
+  scheduler_init(&sched, TICK_US, NULL);
+  run("sobrecarga", probes, count_of(probes), 0, 50000);
+  CHECK(sched.late_ticks > 0 && probes[2].task->overruns > 0, "sobrecarga sem ticks perdidos");
+}
+
+static void check_wraparound(void) {
+  // Contador de ticks e relogio de 32 bits dando a volta no meio do teste
+  probe_t probes[] = {
+    { "entrada", 1, 0, 0 },
+    { "display", 20, 4, 0 },
+  };
+  hal_host_advance_us(0u - hal_time_us() - 50 * TICK_US);
+  scheduler_init(&sched, TICK_US, NULL);
+  run("volta do contador", probes, count_of(probes), 0u - 100, 300);
+  CHECK(hal_time_us() < 1000000u, "o relogio nao deu a volta");
+  CHECK_EQ(sched.late_ticks, 0);
+  CHECK_EQ(probes[0].jitter_max, 0);
+  CHECK_EQ(probes[0].runs, 300);
+  CHECK_EQ(probes[1].runs, 15);
+}
+
+int main(void) {
+  hal_init();
+  hal_host_set_virtual_clock(true);
+  check_light_load();
+  check_overload();
+  check_wraparound();
+  return TEST_RESULT();
+}
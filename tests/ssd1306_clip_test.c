@@ -0,0 +1,130 @@
+// Fuzz do recorte (contrato de ssd1306_set_clip): com area de recorte e
+// coordenadas com sinal aleatorias, nenhuma primitiva altera pixels fora da
+// area, o byte de controle ou memoria fora do framebuffer (compilado com
+// AddressSanitizer), e as alteracoes ficam dentro da janela suja. Exceto a
+// linha, que recomeca o Bresenham no ponto recortado, o que sobra dentro da
+// area e igual ao desenho sem recorte.
+#include <string.h>
+#include "test.h"
+#include "inc/ssd1306.h"
+
+#define ITERATIONS 50000
+
+static ssd1306_t ssd, full;
+static uint32_t seed = 0x5EED0007u;
+
+static bool pixel(const ssd1306_t *s, int x, int y) {
+  return (s->ram_buffer[1 + (x << 3) + (y >> 3)] >> (y & 7)) & 1;
+}
+
+// Coordenada com sinal: quase sempre perto da tela, as vezes nos extremos de 16 bits
+static int16_t coord(void) {
+  uint32_t r = test_random(&seed);
+  if ((r & 31) == 0)
+    return (int16_t)(test_random(&seed) & 0xFFFF);
+  return (int16_t)((int)(r >> 8) % 400 - 140);
+}
+
+static void clear_dirty(ssd1306_t *s) {
+  s->dirty_x0 = 0xFF;
+  s->dirty_x1 = 0;
+  s->dirty_page0 = 0xFF;
+  s->dirty_page1 = 0;
+}
+
+static const char *draw(ssd1306_t *s, int op, const int16_t *a, bool value, const char *text, uint8_t *block) {
+  switch (op) {
+    case 0: ssd1306_pixel(s, a[0], a[1], value); return "pixel";
+    case 1: ssd1306_fill_rect(s, a[1], a[0], a[2], a[3], value); return "fill_rect";
+    case 2: ssd1306_rect(s, a[1], a[0], a[2], a[3], value, false); return "rect";
+    case 3: ssd1306_hline(s, a[0], a[2], a[1], value); return "hline";
+    case 4: ssd1306_vline(s, a[0], a[1], a[3], value); return "vline";
+    case 5: ssd1306_draw_char(s, text[0], a[0], a[1]); return "draw_char";
+    case 6: ssd1306_draw_string(s, text, a[0], a[1]); return "draw_string";
+    case 7: ssd1306_draw_text(s, &font_5x7, text, a[0], a[1]); return "draw_text";
+    case 8: ssd1306_draw_text(s, &font_5x7_x2, text, a[0], a[1]); return "draw_text x2";
+    case 9:
+      ssd1306_write_pages(s, a[0], (uint8_t)a[1] & 15, (uint8_t)a[2], (uint8_t)a[3] & 7, block);
+      return "write_pages";
+    default: ssd1306_line(s, a[0], a[1], a[2], a[3], value); return "line";
+  }
+}
+
+int main(void) {
+  ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, NULL);
+  ssd1306_init(&full, WIDTH, HEIGHT, false, 0x3C, NULL);
+  static uint8_t before[WIDTH * HEIGHT / 8];
+  static uint8_t block[256 * 8];
+  static const char *const texts[] = { "A", "CALIBRANDO 42", "fps 50\nbus 3.1ms", "!" };
+
+  for (int i = 0; i < ITERATIONS; ++i) {
+    // Fundo e recorte aleatorios; o recorte pode ser vazio ou passar da tela
+    for (size_t b = 1; b < ssd.bufsize; ++b)
+      ssd.ram_buffer[b] = (uint8_t)test_random(&seed);
+    memcpy(before, &ssd.ram_buffer[1], sizeof(before));
+    memcpy(&full.ram_buffer[1], before, sizeof(before));
+    int16_t cx0 = coord(), cy0 = coord(), cx1 = coord(), cy1 = coord();
+    if (i & 1) {
+      // Metade dos casos com um recorte pequeno dentro da tela
+      cx0 = test_random(&seed) % WIDTH, cy0 = test_random(&seed) % HEIGHT;
+      cx1 = cx0 + test_random(&seed) % 40, cy1 = cy0 + test_random(&seed) % 24;
+    }
+    ssd1306_set_clip(&ssd, cx0, cy0, cx1, cy1);
+    clear_dirty(&ssd);
+
+    int op = test_random(&seed) % 11;
+    int16_t a[4] = { coord(), coord(), coord(), coord() };
+    bool value = test_random(&seed) & 1;
+    const char *text = texts[test_random(&seed) % count_of(texts)];
+    for (size_t b = 0; b < sizeof(block); ++b)
+      block[b] = (uint8_t)test_random(&seed);
+    const char *name = draw(&ssd, op, a, value, text, block);
+    draw(&full, op, a, value, text, block);
+
+    CHECK(ssd.ram_buffer[0] == 0x40, "%s: byte de controle alterado", name);
+    int outside = 0, undirty = 0, differs = 0;
+    for (int x = 0; x < WIDTH; ++x)
+      for (int y = 0; y < HEIGHT; ++y) {
+        bool old = (before[(x << 3) + (y >> 3)] >> (y & 7)) & 1, now = pixel(&ssd, x, y);
+        bool inside = x >= ssd.clip_x0 && x <= ssd.clip_x1 && y >= ssd.clip_y0 && y <= ssd.clip_y1;
+        if (!inside) {
+          outside += now != old;
+          continue;
+        }
+        if (now != old && (x < ssd.dirty_x0 || x > ssd.dirty_x1 || (y >> 3) < ssd.dirty_page0 ||
+                           (y >> 3) > ssd.dirty_page1))
+          undirty++;
+        if (op != 10 && now != pixel(&full, x, y))
+          differs++;
+      }
+    CHECK(!outside, "%s #%d (%d, %d, %d, %d) com recorte (%d, %d)-(%d, %d): %d pixels fora do recorte",
+          name, i, a[0], a[1], a[2], a[3], cx0, cy0, cx1, cy1, outside);
+    CHECK(!undirty, "%s #%d (%d, %d, %d, %d): %d pixels alterados fora da janela suja", name, i, a[0], a[1],
+          a[2], a[3], undirty);
+    CHECK(!differs, "%s #%d (%d, %d, %d, %d) com recorte (%d, %d)-(%d, %d): %d pixels diferentes do desenho "
+          "sem recorte", name, i, a[0], a[1], a[2], a[3], cx0, cy0, cx1, cy1, differs);
+
+    // Leitura de blocos: so os pixels dentro do recorte chegam ao destino
+    uint8_t x = (uint8_t)coord(), page = test_random(&seed) % 10, width = test_random(&seed) % 140;
+    uint8_t pages = 1 + test_random(&seed) % 8;
+    static uint8_t dst[256 * 8], dst_before[256 * 8];
+    for (size_t b = 0; b < sizeof(dst); ++b)
+      dst[b] = dst_before[b] = (uint8_t)test_random(&seed);
+    ssd1306_read_pages(&ssd, (int8_t)x, page, width, pages, dst);
+    int wrong = 0;
+    for (int col = 0; col < width; ++col)
+      for (int row = 0; row < pages * 8; ++row) {
+        int px = (int8_t)x + col, py = (page << 3) + row;
+        bool inside = px >= ssd.clip_x0 && px <= ssd.clip_x1 && py >= ssd.clip_y0 && py <= ssd.clip_y1;
+        uint8_t byte = dst[col * pages + (row >> 3)], old = dst_before[col * pages + (row >> 3)];
+        bool got = (byte >> (row & 7)) & 1;
+        bool want = inside ? pixel(&ssd, px, py) : (old >> (row & 7)) & 1;
+        wrong += got != want;
+      }
+    CHECK(!wrong, "read_pages #%d (%d, %d, %d, %d) com recorte (%d, %d)-(%d, %d): %d bits errados", i,
+          (int8_t)x, page, width, pages, cx0, cy0, cx1, cy1, wrong);
+    CHECK(!memcmp(dst + width * pages, dst_before + width * pages, sizeof(dst) - width * pages),
+          "read_pages #%d: escreveu depois do bloco", i);
+  }
+  return TEST_RESULT();
+}
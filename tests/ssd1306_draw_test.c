@@ -0,0 +1,329 @@
+// Primitivas de desenho e texto do ssd1306 contra um modelo pixel a pixel e
+// contra quadros de referencia em tests/golden (PBM texto, P1).
+//   ssd1306_draw_test tests/golden            compara
+//   ssd1306_draw_test tests/golden --update   regrava as referencias
+#include <string.h>
+#include "test.h"
+#include "inc/ssd1306.h"
+
+static ssd1306_t ssd;
+static const char *golden_dir;
+static bool update;
+
+// ======= Modelo de referencia =======
+// Coordenadas em int, sem estouro para qualquer argumento int16_t; os lacos
+// comecam e terminam na tela para os trechos de dezenas de milhares de pixels
+static bool ref[HEIGHT][WIDTH];
+
+static int clamp(int v, int lo, int hi) {
+  return v < lo ? lo : v > hi ? hi : v;
+}
+
+static void ref_pixel(int x, int y, bool value) {
+  if (x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT)
+    ref[y][x] = value;
+}
+
+static void ref_fill_rect(int top, int left, int width, int height, bool value) {
+  for (int y = clamp(top, 0, HEIGHT); y < clamp(top + height, 0, HEIGHT); ++y)
+    for (int x = clamp(left, 0, WIDTH); x < clamp(left + width, 0, WIDTH); ++x)
+      ref_pixel(x, y, value);
+}
+
+static void ref_hline(int x0, int x1, int y, bool value) {
+  for (int x = clamp(x0, 0, WIDTH); x <= clamp(x1, -1, WIDTH - 1); ++x)
+    ref_pixel(x, y, value);
+}
+
+static void ref_vline(int x, int y0, int y1, bool value) {
+  for (int y = clamp(y0, 0, HEIGHT); y <= clamp(y1, -1, HEIGHT - 1); ++y)
+    ref_pixel(x, y, value);
+}
+
+static void ref_rect(int top, int left, int width, int height, bool value) {
+  if (width <= 0 || height <= 0)
+    return;
+  ref_hline(left, left + width - 1, top, value);
+  ref_hline(left, left + width - 1, top + height - 1, value);
+  ref_vline(left, top, top + height - 1, value);
+  ref_vline(left + width - 1, top, top + height - 1, value);
+}
+
+// Glifo pixel a pixel a partir do bitmap em colunas da fonte
+static void ref_glyph(const font_t *font, char c, int x, int y, bool opaque) {
+  const font_glyph_t *g = font_glyph(font, c);
+  int pages = (g->height + 7) >> 3;
+  for (int col = 0; col < g->width; ++col)
+    for (int row = 0; row < g->height; ++row) {
+      bool bit = (font->bitmap[g->offset + col * pages + (row >> 3)] >> (row & 7)) & 1;
+      if (opaque || bit)
+        ref_pixel(x + g->x_offset + col, y + g->y_offset + row, bit);
+    }
+}
+
+static bool fb_pixel(int x, int y) {
+  return (ssd.ram_buffer[1 + (x << 3) + (y >> 3)] >> (y & 7)) & 1;
+}
+
+// Primeira diferenca entre o framebuffer e o modelo; false se iguais
+static bool fb_differs(int *dx, int *dy) {
+  for (int x = 0; x < WIDTH; ++x)
+    for (int y = 0; y < HEIGHT; ++y)
+      if (fb_pixel(x, y) != ref[y][x]) {
+        *dx = x, *dy = y;
+        return true;
+      }
+  return false;
+}
+
+static void check_against_model(void) {
+  // Retangulos e linhas aleatorios, inclusive fora da tela e degenerados
+  uint32_t seed = 0xC0FFEEu;
+  ssd1306_fill(&ssd, false);
+  memset(ref, 0, sizeof(ref));
+  for (int i = 0; i < 20000; ++i) {
+    int op = test_random(&seed) % 5;
+    int a = (int)(test_random(&seed) % 220) - 40, b = (int)(test_random(&seed) % 150) - 40;
+    int c = (int)(test_random(&seed) % 160) - 5, d = (int)(test_random(&seed) % 90) - 5;
+    bool value = test_random(&seed) & 1;
+    switch (op) {
+      case 0:
+        ssd1306_fill_rect(&ssd, b, a, c, d, value);
+        ref_fill_rect(b, a, c, d, value);
+        break;
+      case 1:
+        ssd1306_rect(&ssd, b, a, c, d, value, true);
+        ref_fill_rect(b, a, c, d, value);
+        break;
+      case 2:
+        ssd1306_rect(&ssd, b, a, c, d, value, false);
+        ref_rect(b, a, c, d, value);
+        break;
+      case 3:
+        ssd1306_hline(&ssd, a, a + c, b, value);
+        ref_hline(a, a + c, b, value);
+        break;
+      default:
+        ssd1306_vline(&ssd, a, b, b + d, value);
+        ref_vline(a, b, b + d, value);
+        break;
+    }
+    int x, y;
+    if (fb_differs(&x, &y)) {
+      CHECK(false, "operacao %d #%d (%d, %d, %d, %d, %d): pixel (%d, %d)", op, i, a, b, c, d, value, x, y);
+      break;
+    }
+  }
+  CHECK_EQ(ssd.ram_buffer[0], 0x40);
+}
+
+// Coordenada perto da tela ou nos extremos de int16_t
+static int16_t extreme_coord(uint32_t *seed) {
+  static const int16_t extremes[] = { INT16_MIN, -30000, -20000, 20000, 30000, INT16_MAX };
+  uint32_t r = test_random(seed);
+  if (r % 3)
+    return extremes[(r >> 8) % count_of(extremes)];
+  return (int16_t)((int)(r >> 8) % 200 - 40);
+}
+
+static void check_extremes_against_model(void) {
+  // Trechos de dezenas de milhares de pixels: as bordas calculadas como
+  // origem + tamanho - 1 passam de int16_t e nao podem dar a volta
+  static const struct {
+    int op;
+    int16_t a, b, c, d;
+  } cases[] = {
+    { 0, 100, 0, 32767, 8 },       // fill_rect ate o fim da tela
+    { 2, 100, 10, 32767, 8 },      // contorno sem a borda direita
+    { 0, -30000, -30000, 30100, 30010 },
+    { 2, -1, -1, 32767, 32767 },
+    { 3, -30000, 5, 30000, 0 },    // hline(a, c, b)
+    { 4, 10, -30000, 0, 30000 },   // vline(a, b, d)
+    { 4, 127, INT16_MIN, 0, INT16_MAX },
+  };
+  uint32_t seed = 0xE87E3Eu;
+  ssd1306_fill(&ssd, false);
+  memset(ref, 0, sizeof(ref));
+  for (int i = 0; i < 5000 + (int)count_of(cases); ++i) {
+    int op, a, b, c, d;
+    if (i < (int)count_of(cases)) {
+      op = cases[i].op, a = cases[i].a, b = cases[i].b, c = cases[i].c, d = cases[i].d;
+    } else {
+      op = test_random(&seed) % 5;
+      a = extreme_coord(&seed), b = extreme_coord(&seed), c = extreme_coord(&seed), d = extreme_coord(&seed);
+    }
+    bool value = i < (int)count_of(cases) || (test_random(&seed) & 1);
+    switch (op) {
+      case 0:
+        ssd1306_fill_rect(&ssd, b, a, c, d, value);
+        ref_fill_rect(b, a, c, d, value);
+        break;
+      case 1:
+        ssd1306_rect(&ssd, b, a, c, d, value, true);
+        ref_fill_rect(b, a, c, d, value);
+        break;
+      case 2:
+        ssd1306_rect(&ssd, b, a, c, d, value, false);
+        ref_rect(b, a, c, d, value);
+        break;
+      case 3:
+        ssd1306_hline(&ssd, a, c, b, value);
+        ref_hline(a, c, b, value);
+        break;
+      default:
+        ssd1306_vline(&ssd, a, b, d, value);
+        ref_vline(a, b, d, value);
+        break;
+    }
+    int x, y;
+    if (fb_differs(&x, &y)) {
+      CHECK(false, "extremos, operacao %d #%d (%d, %d, %d, %d, %d): pixel (%d, %d)", op, i, a, b, c, d, value, x,
+            y);
+      break;
+    }
+  }
+  CHECK_EQ(ssd.ram_buffer[0], 0x40);
+}
+
+static void check_glyphs_against_model(void) {
+  // Glifos em todas as fases de pagina e parcialmente fora da tela, opacos
+  // (ssd1306_draw_char) e transparentes (ssd1306_draw_text) sobre um fundo
+  // aleatorio
+  static const font_t *const fonts[] = { &font_5x7, &font_5x7_x2 };
+  uint32_t seed = 0xF047u;
+  for (int i = 0; i < 20000; ++i) {
+    int x = (int)(test_random(&seed) % 150) - 12, y = (int)(test_random(&seed) % 90) - 14;
+    char c = (char)(32 + test_random(&seed) % 96);
+    if (i % 64 == 0) {
+      for (size_t b = 1; b < ssd.bufsize; ++b)
+        ssd.ram_buffer[b] = (uint8_t)test_random(&seed);
+      for (int py = 0; py < HEIGHT; ++py)
+        for (int px = 0; px < WIDTH; ++px)
+          ref[py][px] = fb_pixel(px, py);
+    }
+    const char *what;
+    if (i & 1) {
+      const font_t *font = fonts[(i >> 1) % count_of(fonts)];
+      char text[2] = { c, 0 };
+      ssd1306_draw_text(&ssd, font, text, x, y);
+      ref_glyph(font, c, x, y, false);
+      what = font == &font_5x7 ? "draw_text 5x7" : "draw_text 5x7_x2";
+    } else {
+      ssd1306_draw_char(&ssd, c, x, y);
+      ref_glyph(&font_8x8, c, x, y, true);
+      what = "draw_char";
+    }
+    int dx, dy;
+    if (fb_differs(&dx, &dy)) {
+      CHECK(false, "%s '%c' em (%d, %d): pixel (%d, %d)", what, c, x, y, dx, dy);
+      break;
+    }
+  }
+  CHECK_EQ(ssd.ram_buffer[0], 0x40);
+}
+
+// ======= Referencias =======
+static void golden_check(const char *name) {
+  char path[512];
+  snprintf(path, sizeof(path), "%s/%s.pbm", golden_dir, name);
+  if (update) {
+    FILE *f = fopen(path, "w");
+    CHECK(f, "%s: nao foi possivel gravar", path);
+    if (!f)
+      return;
+    fprintf(f, "P1\n%d %d\n", WIDTH, HEIGHT);
+    for (int y = 0; y < HEIGHT; ++y) {
+      for (int x = 0; x < WIDTH; ++x)
+        fputc(fb_pixel(x, y) ? '1' : '0', f);
+      fputc('\n', f);
+    }
+    fclose(f);
+    return;
+  }
+
+  FILE *f = fopen(path, "r");
+  int w = 0, h = 0;
+  CHECK(f && fscanf(f, "P1 %d %d", &w, &h) == 2 && w == WIDTH && h == HEIGHT, "%s: referencia invalida", path);
+  if (!f)
+    return;
+  int mismatches = 0, first_x = -1, first_y = -1;
+  for (int y = 0; y < HEIGHT; ++y)
+    for (int x = 0; x < WIDTH; ++x) {
+      int c;
+      while ((c = fgetc(f)) == ' ' || c == '\n' || c == '\r' || c == '\t')
+        ;
+      if ((c == '1') != fb_pixel(x, y) && mismatches++ == 0)
+        first_x = x, first_y = y;
+    }
+  fclose(f);
+  CHECK(!mismatches, "%s: %d pixels diferentes, o primeiro em (%d, %d)", name, mismatches, first_x, first_y);
+}
+
+static void scene_primitives(void) {
+  ssd1306_fill(&ssd, false);
+  // Retangulos cheios alinhados e desalinhados as paginas, e um apagado dentro
+  ssd1306_rect(&ssd, 0, 0, 20, 8, true, true);
+  ssd1306_rect(&ssd, 11, 3, 14, 19, true, true);
+  ssd1306_rect(&ssd, 14, 6, 8, 5, false, true);
+  // Contornos, um deles passando da borda
+  ssd1306_rect(&ssd, 34, 0, 24, 13, true, false);
+  ssd1306_rect(&ssd, 50, 110, 30, 30, true, false);
+  ssd1306_rect(&ssd, 2, 26, 1, 1, true, false);
+  // Linhas horizontais e verticais nos limites das paginas
+  ssd1306_hline(&ssd, 28, 60, 7, true);
+  ssd1306_hline(&ssd, 28, 60, 8, true);
+  ssd1306_vline(&ssd, 62, 0, 63, true);
+  ssd1306_vline(&ssd, 64, 5, 12, true);
+  // Bresenham em todos os octantes a partir de um centro
+  static const int8_t ends[][2] = {
+    { 30, 0 }, { 30, 12 }, { 30, 30 }, { 12, 30 }, { 0, 30 }, { -12, 30 }, { -30, 30 }, { -30, 12 },
+    { -30, 0 }, { -30, -12 }, { -30, -30 }, { -12, -30 }, { 0, -30 }, { 12, -30 }, { 30, -30 }, { 30, -12 },
+  };
+  for (size_t i = 0; i < count_of(ends); ++i)
+    ssd1306_line(&ssd, 95, 31, 95 + ends[i][0], 31 + ends[i][1], true);
+  // Pixels isolados, um fora da tela
+  ssd1306_pixel(&ssd, 127, 0, true);
+  ssd1306_pixel(&ssd, 128, 0, true);
+  golden_check("primitivas");
+
+  // Tela cheia com retangulos apagados
+  ssd1306_fill(&ssd, true);
+  ssd1306_fill_rect(&ssd, 3, 3, 122, 58, false);
+  ssd1306_fill_rect(&ssd, 20, 40, 48, 24, true);
+  ssd1306_line(&ssd, 0, 63, 127, 0, false);
+  golden_check("primitivas_invertidas");
+}
+
+static void scene_text(void) {
+  ssd1306_fill(&ssd, false);
+  // Fonte 8x8 alinhada, desalinhada e com quebra no fim da linha
+  ssd1306_draw_string(&ssd, "CALIBRANDO", 0, 0);
+  ssd1306_draw_string(&ssd, "AB 12", 85, 11);
+  ssd1306_draw_string(&ssd, "0123456789ABCDEFXY", 3, 21);
+  // Celula opaca sobre um retangulo aceso
+  ssd1306_rect(&ssd, 40, 100, 28, 12, true, true);
+  ssd1306_draw_string(&ssd, "OK", 104, 42);
+  // Proporcional com quebra de linha, e em escala 2 cortada na base
+  ssd1306_draw_text(&ssd, &font_5x7, "Hello, world!\nfps 50 r 1.2ms", 0, 40);
+  ssd1306_draw_text(&ssd, &font_5x7_x2, "Qj", 70, 52);
+  // Parcialmente fora da tela a esquerda e no topo
+  ssd1306_draw_char(&ssd, 'M', -3, -4);
+  golden_check("texto");
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "uso: %s diretorio_das_referencias [--update]\n", argv[0]);
+    return 2;
+  }
+  golden_dir = argv[1];
+  update = argc > 2 && strcmp(argv[2], "--update") == 0;
+
+  ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, NULL);
+  check_against_model();
+  check_extremes_against_model();
+  check_glyphs_against_model();
+  scene_primitives();
+  scene_text();
+  return TEST_RESULT();
+}
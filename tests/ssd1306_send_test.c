@@ -0,0 +1,124 @@
+// Envio do framebuffer conferido no emulador do painel: depois de cada
+// ssd1306_send_data, send_dirty, send_diff e send_diff_async (palavras
+// IC_DATA_CMD pelo backend do emulador) a GDDRAM e igual ao framebuffer; o
+// diff e a janela suja nao enviam nada sem mudancas e nunca mais que a
+// janela das mudancas; cada janela custa uma transacao de comandos em lote e
+// uma de dados, sem erros de enquadramento. A configuracao vai em uma
+// transacao (eram 25, um comando por vez) e um quadro inteiro em 2
+// transacoes e 1034 bytes no barramento (eram 7 e 1044).
+#include <string.h>
+#include "test.h"
+#include "inc/ssd1306.h"
+#include "inc/ssd1306_emu.h"
+
+#define ADDRESS 0x3C
+#define FRAMES 4000
+
+static ssd1306_t ssd;
+static ssd1306_emu_t emu;
+
+// Bytes da GDDRAM diferentes do framebuffer
+static int gddram_mismatches(void) {
+  int count = 0;
+  for (int x = 0; x < WIDTH; ++x)
+    for (int p = 0; p < HEIGHT / 8; ++p)
+      count += emu.gddram[p][x] != ssd.ram_buffer[1 + (x << 3) + p];
+  return count;
+}
+
+// Bytes da janela (colunas x paginas) que contem todas as mudancas
+static int changed_window_bytes(const uint8_t *old) {
+  int x0 = WIDTH, x1 = -1, p0 = 8, p1 = -1;
+  for (int x = 0; x < WIDTH; ++x)
+    for (int p = 0; p < HEIGHT / 8; ++p)
+      if (old[(x << 3) + p] != ssd.ram_buffer[1 + (x << 3) + p]) {
+        if (x < x0) x0 = x;
+        if (x > x1) x1 = x;
+        if (p < p0) p0 = p;
+        if (p > p1) p1 = p;
+      }
+  return x1 < 0 ? 0 : (x1 - x0 + 1) * (p1 - p0 + 1);
+}
+
+static void random_edit(uint32_t *seed) {
+  // Algumas mudancas pequenas por quadro, como a aplicacao faz
+  int n = test_random(seed) % 4;
+  for (int i = 0; i < n; ++i) {
+    int x = test_random(seed) % WIDTH, y = test_random(seed) % HEIGHT;
+    switch (test_random(seed) % 4) {
+      case 0: ssd1306_pixel(&ssd, x, y, test_random(seed) & 1); break;
+      case 1: ssd1306_rect(&ssd, y, x, 1 + test_random(seed) % 20, 1 + test_random(seed) % 20, true, true); break;
+      case 2: ssd1306_rect(&ssd, y, x, 1 + test_random(seed) % 20, 1 + test_random(seed) % 20, false, true); break;
+      default: ssd1306_draw_text(&ssd, &font_5x7, "42", x, y); break;
+    }
+  }
+}
+
+int main(void) {
+  ssd1306_emu_init(&emu, ADDRESS);
+  hal_host_set_i2c_sink(ssd1306_emu_i2c_sink, &emu);
+  ssd1306_init(&ssd, WIDTH, HEIGHT, false, ADDRESS, hal_i2c_init(0, 400000, 0, 0));
+  ssd1306_config(&ssd);
+  CHECK_EQ(emu.unknown_commands, 0);
+  CHECK(emu.display_on && emu.mem_mode == 1, "configuracao nao aplicada");
+  // Os 16 comandos da tabela, 25 bytes com os argumentos, em um lote:
+  // endereco, byte de controle e os comandos
+  ssd1306_bus_stats_t stats;
+  ssd1306_emu_end_frame(&emu, &stats);
+  CHECK_EQ(stats.transactions, 1);
+  CHECK_EQ(stats.command_bytes, 25);
+  CHECK_EQ(stats.bytes, 27);
+
+  ssd1306_fill(&ssd, false);
+  ssd1306_draw_string(&ssd, "INICIO", 10, 10);
+  ssd1306_send_data(&ssd);
+  CHECK_EQ(gddram_mismatches(), 0);
+  // Janela de enderecos em um lote (endereco, controle e 6 bytes) e os dados
+  // (endereco, 0x40 e 1024 bytes)
+  ssd1306_emu_end_frame(&emu, &stats);
+  CHECK_EQ(stats.transactions, 2);
+  CHECK_EQ(stats.command_bytes, 6);
+  CHECK_EQ(stats.data_bytes, WIDTH * HEIGHT / 8);
+  CHECK_EQ(stats.bytes, 1034);
+
+  static const char *const modes[] = { "send_dirty", "send_diff", "send_diff_async" };
+  static uint8_t old[WIDTH * HEIGHT / 8];
+  uint32_t seed = 0xD1FFu;
+  for (int frame = 0; frame < FRAMES; ++frame) {
+    int mode = frame / 16 % 3;
+    // O backend assincrono so existe nos blocos de send_diff_async
+    ssd1306_set_async_backend(&ssd, mode == 2 ? ssd1306_emu_async_backend(&emu) : NULL);
+    memcpy(old, &ssd.ram_buffer[1], sizeof(old));
+    random_edit(&seed);
+    int window = changed_window_bytes(old);
+
+    if (mode == 0)
+      ssd1306_send_dirty(&ssd);
+    else if (mode == 1)
+      ssd1306_send_diff(&ssd);
+    else
+      ssd1306_send_diff_async(&ssd);
+    ssd1306_wait(&ssd);
+    ssd1306_emu_end_frame(&emu, &stats);
+
+    int mismatches = gddram_mismatches();
+    CHECK(!mismatches, "%s, quadro %d: %d bytes da GDDRAM diferentes", modes[mode], frame, mismatches);
+    if (!window && mode != 0) {
+      CHECK(!stats.transactions, "%s, quadro %d: %lu transacoes sem mudancas", modes[mode], frame,
+            (unsigned long)stats.transactions);
+      continue;
+    }
+    // A janela suja pode passar da janela das mudancas (um pixel reescrito
+    // com o mesmo valor); os grupos do diff ficam sempre dentro dela
+    if (mode != 0)
+      CHECK(stats.data_bytes <= (uint32_t)window, "%s, quadro %d: %lu bytes de dados para %d alterados",
+            modes[mode], frame, (unsigned long)stats.data_bytes, window);
+    CHECK(stats.transactions % 2 == 0 && stats.command_bytes == 3 * stats.transactions,
+          "%s, quadro %d: %lu transacoes e %lu bytes de comando; esperado um lote de 6 comandos e os dados "
+          "por janela", modes[mode], frame, (unsigned long)stats.transactions, (unsigned long)stats.command_bytes);
+  }
+  CHECK_EQ(emu.framing_errors, 0);
+  CHECK_EQ(emu.nacks, 0);
+  CHECK_EQ(emu.unknown_commands, 0);
+  return TEST_RESULT();
+}
@@ -0,0 +1,92 @@
+#ifndef HARDWARE_INTERP_H
+#define HARDWARE_INTERP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Substituto de hardware/interp.h do pico-sdk para os testes do host: mesmos
+// registradores, mesma API e mesmo layout de CTRL_LANEx; o resultado das
+// lanes e calculado em software por interp_model.c na leitura de PEEK.
+// Modelados: SHIFT, MASK_LSB/MSB, SIGNED, CROSS_INPUT, ADD_RAW, BLEND (so no
+// interp0) e CLAMP (so no interp1); CROSS_RESULT, FORCE_MSB e POP nao.
+
+typedef unsigned int uint;
+
+typedef struct {
+  uint32_t accum[2];
+  uint32_t base[3];
+  uint32_t ctrl[2];
+} interp_hw_t;
+
+extern interp_hw_t interp_model_hw[2];
+#define interp0 (&interp_model_hw[0])
+#define interp1 (&interp_model_hw[1])
+
+#define SIO_INTERP0_CTRL_LANE0_SHIFT_LSB 0
+#define SIO_INTERP0_CTRL_LANE0_SHIFT_BITS 0x0000001fu
+#define SIO_INTERP0_CTRL_LANE0_MASK_LSB_LSB 5
+#define SIO_INTERP0_CTRL_LANE0_MASK_LSB_BITS 0x000003e0u
+#define SIO_INTERP0_CTRL_LANE0_MASK_MSB_LSB 10
+#define SIO_INTERP0_CTRL_LANE0_MASK_MSB_BITS 0x00007c00u
+#define SIO_INTERP0_CTRL_LANE0_SIGNED_BITS 0x00008000u
+#define SIO_INTERP0_CTRL_LANE0_CROSS_INPUT_BITS 0x00010000u
+#define SIO_INTERP0_CTRL_LANE0_ADD_RAW_BITS 0x00040000u
+#define SIO_INTERP0_CTRL_LANE0_BLEND_BITS 0x00200000u
+#define SIO_INTERP1_CTRL_LANE0_CLAMP_BITS 0x00400000u
+
+typedef struct {
+  uint32_t ctrl;
+} interp_config;
+
+static inline interp_config interp_default_config(void) {
+  // Sem shift, mascara de 32 bits, o resto desligado
+  interp_config c = { 31u << SIO_INTERP0_CTRL_LANE0_MASK_MSB_LSB };
+  return c;
+}
+
+static inline void interp_config_set_shift(interp_config *c, uint shift) {
+  c->ctrl = (c->ctrl & ~SIO_INTERP0_CTRL_LANE0_SHIFT_BITS) | (shift << SIO_INTERP0_CTRL_LANE0_SHIFT_LSB);
+}
+
+static inline void interp_config_set_mask(interp_config *c, uint mask_lsb, uint mask_msb) {
+  c->ctrl = (c->ctrl & ~(SIO_INTERP0_CTRL_LANE0_MASK_LSB_BITS | SIO_INTERP0_CTRL_LANE0_MASK_MSB_BITS)) |
+            (mask_lsb << SIO_INTERP0_CTRL_LANE0_MASK_LSB_LSB) | (mask_msb << SIO_INTERP0_CTRL_LANE0_MASK_MSB_LSB);
+}
+
+static inline void interp_config_set_signed(interp_config *c, bool _signed) {
+  c->ctrl = (c->ctrl & ~SIO_INTERP0_CTRL_LANE0_SIGNED_BITS) | (_signed ? SIO_INTERP0_CTRL_LANE0_SIGNED_BITS : 0);
+}
+
+static inline void interp_config_set_cross_input(interp_config *c, bool cross_input) {
+  c->ctrl = (c->ctrl & ~SIO_INTERP0_CTRL_LANE0_CROSS_INPUT_BITS) |
+            (cross_input ? SIO_INTERP0_CTRL_LANE0_CROSS_INPUT_BITS : 0);
+}
+
+static inline void interp_config_set_add_raw(interp_config *c, bool add_raw) {
+  c->ctrl = (c->ctrl & ~SIO_INTERP0_CTRL_LANE0_ADD_RAW_BITS) | (add_raw ? SIO_INTERP0_CTRL_LANE0_ADD_RAW_BITS : 0);
+}
+
+static inline void interp_config_set_blend(interp_config *c, bool blend) {
+  c->ctrl = (c->ctrl & ~SIO_INTERP0_CTRL_LANE0_BLEND_BITS) | (blend ? SIO_INTERP0_CTRL_LANE0_BLEND_BITS : 0);
+}
+
+static inline void interp_config_set_clamp(interp_config *c, bool clamp) {
+  c->ctrl = (c->ctrl & ~SIO_INTERP1_CTRL_LANE0_CLAMP_BITS) | (clamp ? SIO_INTERP1_CTRL_LANE0_CLAMP_BITS : 0);
+}
+
+static inline void interp_set_config(interp_hw_t *interp, uint lane, const interp_config *config) {
+  interp->ctrl[lane] = config->ctrl;
+}
+
+static inline void interp_set_base(interp_hw_t *interp, uint lane, uint32_t val) {
+  interp->base[lane] = val;
+}
+
+static inline void interp_set_accumulator(interp_hw_t *interp, uint lane, uint32_t val) {
+  interp->accum[lane] = val;
+}
+
+// PEEK0/PEEK1/PEEK2: resultado da lane sem alterar os acumuladores
+uint32_t interp_peek_lane_result(interp_hw_t *interp, uint lane);
+
+#endif
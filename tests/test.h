@@ -0,0 +1,43 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Verificacoes dos testes do host (ctest). Cada teste e um executavel: as
+// falhas sao impressas com arquivo e linha e contadas, e main devolve
+// TEST_RESULT(). So as primeiras falhas de um mesmo CHECK em laco aparecem.
+static unsigned test_failures;
+
+#define TEST_MAX_REPORTS 20
+
+#define CHECK(cond, ...)                                       \
+  do {                                                         \
+    if (!(cond)) {                                             \
+      if (test_failures++ < TEST_MAX_REPORTS) {                \
+        fprintf(stderr, "%s:%d: falhou: %s: ", __FILE__, __LINE__, #cond); \
+        fprintf(stderr, __VA_ARGS__);                          \
+        fputc('\n', stderr);                                   \
+      }                                                        \
+    }                                                          \
+  } while (0)
+
+#define CHECK_EQ(actual, expected)                                                     \
+  CHECK((long long)(actual) == (long long)(expected), "%lld, esperado %lld",         \
+        (long long)(actual), (long long)(expected))
+
+#define TEST_RESULT()                                                  \
+  (test_failures ? (fprintf(stderr, "%u falhas\n", test_failures), 1) : 0)
+
+// Gerador pseudoaleatorio (xorshift32) com semente fixa, para entradas
+// reprodutiveis
+static inline uint32_t test_random(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+#endif
@@ -0,0 +1,89 @@
+// Buffer triplo com produtor e consumidor em threads: o consumidor nunca ve
+// um quadro rasgado (metade de uma publicacao, metade de outra), nunca um
+// quadro mais antigo que o ultimo que viu, e o produtor nunca escreve no
+// slot em leitura. Cedencias periodicas nos pontos criticos intercalam as
+// threads mesmo numa maquina de uma CPU
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include "test.h"
+#include "inc/triple_buffer.h"
+
+#define PUBLISHES 500000u
+#define WORDS 16
+
+typedef struct {
+  uint32_t seq;
+  uint32_t words[WORDS];
+} frame_t;
+
+static triple_buffer_t tb;
+static volatile frame_t slots[3];
+static atomic_bool done;
+
+static uint32_t frame_word(uint32_t seq, int i) {
+  return seq * 2654435761u + (uint32_t)i;
+}
+
+static void *producer(void *arg) {
+  for (uint32_t seq = 1; seq <= PUBLISHES; ++seq) {
+    volatile frame_t *f = &slots[triple_buffer_write_slot(&tb)];
+    // Escrita palavra a palavra, sem atomicos: um rasgo apareceria ao leitor
+    f->seq = seq;
+    for (int i = 0; i < WORDS; ++i) {
+      f->words[i] = frame_word(seq, i);
+      if (i == WORDS / 2 && seq % 7 == 0)
+        sched_yield();
+    }
+    triple_buffer_publish(&tb);
+    if (seq % 5 == 0)
+      sched_yield();
+  }
+  atomic_store(&done, true);
+  return NULL;
+}
+
+// Confere o quadro do slot; devolve a sequencia, ou 0 se estiver rasgado
+static uint32_t read_frame(uint8_t slot) {
+  volatile frame_t *f = &slots[slot];
+  uint32_t seq = f->seq;
+  for (int i = 0; i < WORDS; ++i)
+    if (f->words[i] != frame_word(seq, i))
+      return 0;
+  return seq;
+}
+
+int main(void) {
+  triple_buffer_init(&tb);
+  slots[0].seq = 0;
+  for (int i = 0; i < WORDS; ++i)
+    slots[0].words[i] = frame_word(0, i);
+
+  pthread_t thread;
+  pthread_create(&thread, NULL, producer, NULL);
+
+  uint32_t last = 0, acquires = 0, fresh_count = 0;
+  bool finished = false;
+  while (!finished) {
+    // Depois do fim do produtor, uma ultima aquisicao tem de ver a ultima publicacao
+    finished = atomic_load(&done);
+    uint8_t slot;
+    bool fresh = triple_buffer_acquire(&tb, &slot);
+    acquires++;
+    uint32_t seq = read_frame(slot);
+    CHECK(seq || (slot == 0 && slots[0].seq == 0), "quadro rasgado no slot %u", slot);
+    CHECK(seq >= last, "quadro %lu mais antigo que o ultimo visto %lu", (unsigned long)seq, (unsigned long)last);
+    CHECK(fresh == (seq != last), "fresh %d com sequencia %lu apos %lu", fresh, (unsigned long)seq,
+          (unsigned long)last);
+    // Uma segunda leitura do mesmo slot pega o produtor escrevendo nele
+    if (acquires % 3 == 0)
+      sched_yield();
+    CHECK(read_frame(slot) == seq, "slot %u alterado durante a leitura", slot);
+    fresh_count += fresh;
+    last = seq;
+  }
+  pthread_join(thread, NULL);
+  CHECK_EQ(last, PUBLISHES);
+  printf("%lu aquisicoes, %lu com quadro novo\n", (unsigned long)acquires, (unsigned long)fresh_count);
+  return TEST_RESULT();
+}
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Converte uma fonte BDF em tabelas C constantes para inc/fonts.h.
+
+Cada glifo e gravado em colunas de ceil(altura / 8) bytes com o bit 0 no
+topo, o mesmo formato das paginas do SSD1306, para que o texto seja
+desenhado com copias de bytes.
+
+Uso:
+    tools/bdf2font.py fonts/5x7.bdf --name font_5x7 -o inc/fonts/font_5x7.c
+    tools/bdf2font.py fonts/5x7.bdf --name font_5x7_x2 --scale 2 -o inc/fonts/font_5x7_x2.c
+"""
+
+import argparse
+import sys
+
+
+def parse_bdf(path):
+    font = {"ascent": None, "descent": None, "glyphs": {}}
+    glyph = None
+    in_bitmap = False
+    with open(path) as f:
+        for raw in f:
+            line = raw.strip()
+            if not line:
+                continue
+            key, _, rest = line.partition(" ")
+            if in_bitmap:
+                if key == "ENDCHAR":
+                    in_bitmap = False
+                    if glyph["encoding"] >= 0:
+                        font["glyphs"][glyph["encoding"]] = glyph
+                    glyph = None
+                else:
+                    glyph["rows"].append(int(key, 16))
+                continue
+            if key == "FONT_ASCENT":
+                font["ascent"] = int(rest)
+            elif key == "FONT_DESCENT":
+                font["descent"] = int(rest)
+            elif key == "STARTCHAR":
+                glyph = {"name": rest, "encoding": -1, "advance": 0,
+                         "bbx": (0, 0, 0, 0), "rows": []}
+            elif key == "ENCODING":
+                glyph["encoding"] = int(rest.split()[0])
+            elif key == "DWIDTH":
+                glyph["advance"] = int(rest.split()[0])
+            elif key == "BBX":
+                glyph["bbx"] = tuple(int(v) for v in rest.split())
+            elif key == "BITMAP":
+                in_bitmap = True
+    if font["ascent"] is None or font["descent"] is None:
+        sys.exit(f"{path}: FONT_ASCENT/FONT_DESCENT ausentes")
+    return font
+
+
+def glyph_columns(glyph, ascent, scale):
+    """Retorna (colunas, largura, altura, x_offset, y_offset) ja escalados."""
+    w, h, xoff, yoff = glyph["bbx"]
+    rows = glyph["rows"]
+    row_bytes = (w + 7) // 8
+    pixels = []
+    for r in range(h):
+        bits = rows[r] if r < len(rows) else 0
+        pixels.append([(bits >> (row_bytes * 8 - 1 - c)) & 1 for c in range(w)])
+
+    sw, sh = w * scale, h * scale
+    pages = (sh + 7) // 8
+    columns = []
+    for c in range(sw):
+        for p in range(pages):
+            byte = 0
+            for bit in range(8):
+                r = p * 8 + bit
+                if r < sh and pixels[r // scale][c // scale]:
+                    byte |= 1 << bit
+            columns.append(byte)
+    # Distancia do topo da linha (ascent acima da base) ao topo do bitmap
+    top = (ascent - (yoff + h)) * scale
+    return columns, sw, sh, xoff * scale, top
+
+
+def label(code):
+    if code == 0x20:
+        return "espaco"
+    if code == 0x5C:
+        return "barra invertida"
+    return chr(code)
+
+
+def emit(font, name, scale, first, last, fallback, source):
+    ascent, descent = font["ascent"], font["descent"]
+    bitmap = []
+    glyphs = []
+    for code in range(first, last + 1):
+        glyph = font["glyphs"].get(code)
+        if glyph is None:
+            glyphs.append((0, 0, 0, 0, 0, 0, code))
+            continue
+        cols, w, h, xoff, yoff = glyph_columns(glyph, ascent, scale)
+        glyphs.append((len(bitmap), w, h, glyph["advance"] * scale, xoff, yoff, code))
+        bitmap.extend(cols)
+
+    if len(bitmap) > 0xFFFF:
+        sys.exit("bitmap excede 64 KiB")
+
+    out = []
+    out.append(f"// Gerado por tools/bdf2font.py a partir de {source}"
+               + (f" (escala {scale})" if scale != 1 else "") + " - nao editar")
+    out.append('#include "../fonts.h"')
+    out.append("")
+    out.append(f"static const uint8_t {name}_bitmap[] = {{")
+    for offset, w, h, _, _, _, code in glyphs:
+        if not w:
+            continue
+        pages = (h + 7) // 8
+        data = bitmap[offset:offset + w * pages]
+        line = ", ".join(f"0x{b:02x}" for b in data)
+        out.append(f"  {line}, // {label(code)}")
+    out.append("};")
+    out.append("")
+    out.append(f"static const font_glyph_t {name}_glyphs[] = {{")
+    for offset, w, h, adv, xoff, yoff, code in glyphs:
+        out.append(f"  {{ {offset}, {w}, {h}, {adv}, {xoff}, {yoff} }}, // {label(code)}")
+    out.append("};")
+    out.append("")
+    out.append(f"const font_t {name} = {{")
+    out.append(f"  .bitmap = {name}_bitmap,")
+    out.append(f"  .glyphs = {name}_glyphs,")
+    out.append(f"  .first = {first},")
+    out.append(f"  .last = {last},")
+    out.append(f"  .fallback = {fallback},")
+    out.append(f"  .line_height = {(ascent + descent) * scale},")
+    out.append("};")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("bdf")
+    parser.add_argument("--name", required=True, help="nome do simbolo font_t")
+    parser.add_argument("--scale", type=int, default=1, help="fator de escala inteiro")
+    parser.add_argument("--first", type=int, default=32)
+    parser.add_argument("--last", type=int, default=126)
+    parser.add_argument("--fallback", type=int, default=ord("?"))
+    parser.add_argument("-o", "--output", default="-")
+    args = parser.parse_args()
+
+    font = parse_bdf(args.bdf)
+    text = emit(font, args.name, args.scale, args.first, args.last,
+                args.fallback, args.bdf)
+    if args.output == "-":
+        sys.stdout.write(text)
+    else:
+        with open(args.output, "w") as f:
+            f.write(text)
+
+
+if __name__ == "__main__":
+    main()
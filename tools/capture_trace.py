@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""Captura um trace de entrada do firmware pela porta serial USB.
+
+Envia 'c' para ligar o modo de captura, grava os bytes recebidos durante o
+tempo pedido e envia 'c' de novo para desligar. O arquivo comeca no
+cabecalho "AJTR" (texto anterior e descartado) e termina no ultimo registro
+completo; o formato esta descrito em inc/input_trace.h.
+
+Tambem converte entre os formatos binario e texto, para editar traces:
+    tools/capture_trace.py /dev/ttyACM0 captura.bin --seconds 10
+    tools/capture_trace.py --to-text captura.bin captura.txt
+    tools/capture_trace.py --to-binary captura.txt captura.bin
+
+O trace e reproduzido no build do host com
+    build-host/AtividadeADC_host captura.bin saida/
+"""
+
+import argparse
+import os
+import select
+import struct
+import sys
+import termios
+import time
+import tty
+
+MAGIC = b"AJTR"
+VERSION = 2
+HEADER_SIZE = 8
+RECORD_SIZE = 6
+SW = 0x01
+BUTTON_A = 0x02
+GAP = 0x80
+
+
+def header():
+    return MAGIC + bytes([VERSION, RECORD_SIZE, 0, 0])
+
+
+def unpack(data):
+    """Registros (tempo_us, x, y, botoes) de um trace binario."""
+    if data[:4] != MAGIC or not 1 <= data[4] <= VERSION or data[5] != RECORD_SIZE:
+        raise ValueError("cabecalho invalido")
+    t = 0
+    records = []
+    for i in range(HEADER_SIZE, len(data) - RECORD_SIZE + 1, RECORD_SIZE):
+        if data[i + 5] & GAP:
+            t += struct.unpack_from("<I", data, i)[0]
+            continue
+        dt, b2, b3, b4, buttons = struct.unpack_from("<HBBBB", data, i)
+        t += dt
+        records.append((t, b2 | (b3 & 0x0F) << 8, b3 >> 4 | b4 << 4, buttons))
+    return records
+
+
+def pack_record(dt, x, y, buttons):
+    return struct.pack("<HBBBB", dt, x & 0xFF, (x >> 8) & 0x0F | (y & 0x0F) << 4, y >> 4, buttons)
+
+
+def pack(records):
+    """Trace binario; intervalos acima de 65535 us vao num registro de salto,
+    como em input_trace_pack."""
+    out = bytearray(header())
+    last = 0
+    for t, x, y, buttons in records:
+        if t - last > 0xFFFF:
+            out += struct.pack("<IBB", t - last, 0, GAP)
+            last = t
+        out += pack_record(t - last, x, y, buttons)
+        last = t
+    return bytes(out)
+
+
+def buttons_text(buttons):
+    text = ("S" if buttons & SW else "") + ("A" if buttons & BUTTON_A else "")
+    return text or "-"
+
+
+def read_text(path):
+    records = []
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            try:
+                t, x, y, keys = line.split()
+                buttons = (SW if "S" in keys else 0) | (BUTTON_A if "A" in keys else 0)
+                records.append((int(t), int(x), int(y), buttons))
+            except ValueError:
+                sys.exit(f"{path}:{number}: linha invalida")
+    return records
+
+
+def capture(port, seconds):
+    fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+    saved = termios.tcgetattr(fd)
+    try:
+        tty.setraw(fd)
+        termios.tcflush(fd, termios.TCIFLUSH)
+        data = bytearray()
+
+        def drain(duration):
+            end = time.monotonic() + duration
+            while True:
+                remaining = end - time.monotonic()
+                if remaining <= 0:
+                    break
+                ready, _, _ = select.select([fd], [], [], remaining)
+                if ready:
+                    data.extend(os.read(fd, 4096))
+
+        os.write(fd, b"c")
+        drain(seconds)
+        os.write(fd, b"c")
+        # Registros ainda em transito antes do firmware ver o segundo 'c'
+        drain(0.2)
+    finally:
+        termios.tcsetattr(fd, termios.TCSADRAIN, saved)
+        os.close(fd)
+
+    start = data.find(MAGIC)
+    if start < 0:
+        sys.exit("cabecalho do trace nao recebido; o firmware esta rodando?")
+    data = data[start:]
+    return bytes(data[:HEADER_SIZE + (len(data) - HEADER_SIZE) // RECORD_SIZE * RECORD_SIZE])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("source", help="porta serial (ou trace de entrada com --to-text/--to-binary)")
+    parser.add_argument("output", help="arquivo de trace gerado")
+    parser.add_argument("--seconds", type=float, default=10.0, help="duracao da captura")
+    mode = parser.add_mutually_exclusive_group()
+    mode.add_argument("--to-text", action="store_true", help="converte um trace binario para texto")
+    mode.add_argument("--to-binary", action="store_true", help="converte um trace texto para binario")
+    args = parser.parse_args()
+
+    if args.to_text:
+        with open(args.source, "rb") as f:
+            records = unpack(f.read())
+        with open(args.output, "w") as f:
+            f.write("# tempo_us x y botoes\n")
+            for t, x, y, buttons in records:
+                f.write(f"{t} {x} {y} {buttons_text(buttons)}\n")
+    elif args.to_binary:
+        with open(args.output, "wb") as f:
+            f.write(pack(read_text(args.source)))
+    else:
+        data = capture(args.source, args.seconds)
+        with open(args.output, "wb") as f:
+            f.write(data)
+        count = len(unpack(data))
+        print(f"{count} registros em {args.output}")
+
+
+if __name__ == "__main__":
+    main()
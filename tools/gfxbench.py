@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""Relatorio dos microbenchmarks de desenho (bench/gfx_bench.c).
+
+Le as linhas "bench,..." da saida do gfx_bench (arquivo, "-" para a entrada
+padrao ou, com --run, executando o binario do host) e compara o custo por
+chamada com uma referencia gravada. Texto fora dessas linhas, como o que
+vier junto pela serial do Pico, e ignorado.
+
+Uso:
+    tools/gfxbench.py --run build-host/gfx_bench
+    tools/gfxbench.py --run build-host/gfx_bench --save bench.json
+    tools/gfxbench.py --run build-host/gfx_bench --baseline bench.json --threshold 10
+    tools/gfxbench.py captura_serial.txt --baseline bench_pico.json --threshold 5
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+FIELDS = ("primitiva", "caso", "pixels", "iteracoes", "por_chamada", "por_pixel", "unidade")
+
+
+def parse(lines):
+    results = {}
+    for line in lines:
+        parts = line.strip().split(",")
+        if len(parts) != len(FIELDS) + 1 or parts[0] != "bench" or parts[1] == FIELDS[0]:
+            continue
+        row = dict(zip(FIELDS, parts[1:]))
+        key = f"{row['primitiva']}/{row['caso']}"
+        results[key] = {
+            "pixels": int(row["pixels"]),
+            "por_chamada": float(row["por_chamada"]),
+            "por_pixel": float(row["por_pixel"]),
+            "unidade": row["unidade"],
+        }
+    return results
+
+
+def change(new, old):
+    if not old:
+        return None
+    return (new - old) * 100.0 / old
+
+
+def print_report(results, baseline):
+    header = f"{'caso':<40} {'pixels':>7} {'por chamada':>14} {'por pixel':>11}"
+    print(header + ("      ref   delta" if baseline else ""))
+    for key, row in results.items():
+        line = f"{key:<40} {row['pixels']:>7} {row['por_chamada']:>10.1f} {row['unidade']:<3} {row['por_pixel']:>11.3f}"
+        old = baseline.get(key) if baseline else None
+        if old:
+            delta = change(row["por_chamada"], old["por_chamada"])
+            line += f" {old['por_chamada']:>10.1f} " + (f"{delta:>+6.1f}%" if delta is not None else "      -")
+        elif baseline:
+            line += "       (novo)"
+        print(line)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", nargs="?", default="-", help="saida do gfx_bench ('-' para stdin)")
+    parser.add_argument("--run", help="executa o gfx_bench do host e le a sua saida")
+    parser.add_argument("--save", help="grava os resultados em JSON para servir de referencia")
+    parser.add_argument("--baseline", help="JSON de referencia gravado com --save")
+    parser.add_argument("--threshold", type=float, default=0,
+                        help="falha se algum caso ficar mais que N%% mais lento que a referencia")
+    args = parser.parse_args()
+
+    if args.run:
+        lines = subprocess.run([args.run], check=True, capture_output=True, text=True).stdout.splitlines()
+    elif args.input == "-":
+        lines = sys.stdin.readlines()
+    else:
+        with open(args.input, errors="replace") as f:
+            lines = f.readlines()
+
+    results = parse(lines)
+    if not results:
+        sys.exit("nenhuma linha de benchmark encontrada")
+
+    baseline = None
+    if args.baseline and os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    print_report(results, baseline)
+
+    if args.save:
+        with open(args.save, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+
+    if baseline and args.threshold:
+        slower = []
+        for key, row in results.items():
+            old = baseline.get(key)
+            if not old or old["unidade"] != row["unidade"]:
+                continue
+            delta = change(row["por_chamada"], old["por_chamada"])
+            if delta is not None and delta > args.threshold:
+                slower.append(f"{key} ({delta:+.1f}%)")
+        if slower:
+            sys.exit("regressao de desempenho: " + ", ".join(slower))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Relatorio de uso de RAM e flash por modulo a partir do .map do GNU ld.
+
+Soma o tamanho das secoes de entrada de cada arquivo objeto (ou biblioteca)
+e classifica pelo endereco: flash (XIP, 0x10000000) ou RAM (SRAM,
+0x20000000). Secoes .data contam nas duas, pois sao copiadas da flash.
+
+Uso:
+    tools/mapreport.py build/AtividadeADC.elf.map
+    tools/mapreport.py build/AtividadeADC.elf.map --save memoria.json
+    tools/mapreport.py build/AtividadeADC.elf.map --baseline memoria.json --threshold 256
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+from collections import defaultdict
+
+FLASH = (0x10000000, 0x11000000)
+RAM = (0x20000000, 0x20042000)
+
+OUTPUT_RE = re.compile(r"^(\.\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+load address 0x([0-9a-fA-F]+))?")
+INPUT_RE = re.compile(r"^ (\.\S+|COMMON)?\s*0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+NAME_ONLY_RE = re.compile(r"^ (\.\S+|COMMON)\s*$")
+
+
+def in_range(addr, region):
+    return region[0] <= addr < region[1]
+
+
+def module_name(path):
+    """Reduz o caminho do objeto ao modulo: arquivo-fonte ou biblioteca."""
+    path = path.strip()
+    match = re.match(r"(.*\.a)\((.*)\)$", path)
+    if match:
+        return os.path.basename(match.group(1))
+    name = os.path.basename(path)
+    for suffix in (".obj", ".o"):
+        if name.endswith(suffix):
+            name = name[: -len(suffix)]
+    # Objetos do pico-sdk ficam em .../pico-sdk/src/...; agrupa por diretorio
+    if "pico-sdk" in path or "pico_sdk" in path:
+        parts = path.replace("\\", "/").split("/")
+        for i, part in enumerate(parts):
+            if part == "src" and i + 2 < len(parts):
+                return "sdk:" + parts[i + 2]
+    return name
+
+
+def parse_map(path):
+    usage = defaultdict(lambda: {"flash": 0, "ram": 0})
+    in_memory_map = False
+    loads_from_flash = False
+    pending = None
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if line.startswith("Linker script and memory map"):
+                in_memory_map = True
+                continue
+            if not in_memory_map:
+                continue
+
+            out = OUTPUT_RE.match(line)
+            if out:
+                load = out.group(4)
+                loads_from_flash = load is not None and in_range(int(load, 16), FLASH)
+                pending = None
+                continue
+
+            if NAME_ONLY_RE.match(line):
+                pending = line
+                continue
+            if pending and line.startswith("                0x"):
+                line = pending + line
+            pending = None
+
+            entry = INPUT_RE.match(line)
+            if not entry or entry.group(4).startswith("load address"):
+                continue
+            addr, size = int(entry.group(2), 16), int(entry.group(3), 16)
+            if not size:
+                continue
+            module = module_name(entry.group(4))
+            if in_range(addr, FLASH):
+                usage[module]["flash"] += size
+            elif in_range(addr, RAM):
+                usage[module]["ram"] += size
+                if loads_from_flash:
+                    usage[module]["flash"] += size
+    return dict(usage)
+
+
+def print_report(usage, baseline):
+    rows = sorted(usage.items(), key=lambda kv: (-kv[1]["flash"] - kv[1]["ram"], kv[0]))
+    print(f"{'modulo':<40} {'flash':>8} {'ram':>8}" + ("   delta flash   delta ram" if baseline else ""))
+    for module, size in rows:
+        line = f"{module:<40} {size['flash']:>8} {size['ram']:>8}"
+        if baseline:
+            old = baseline.get(module, {"flash": 0, "ram": 0})
+            line += f"   {size['flash'] - old['flash']:>+11} {size['ram'] - old['ram']:>+11}"
+        print(line)
+    total = {k: sum(v[k] for v in usage.values()) for k in ("flash", "ram")}
+    print(f"{'total':<40} {total['flash']:>8} {total['ram']:>8}")
+    return total
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("map")
+    parser.add_argument("--save", help="grava o uso atual em JSON para servir de referencia")
+    parser.add_argument("--baseline", help="JSON de referencia gravado com --save")
+    parser.add_argument("--threshold", type=int, default=None,
+                        help="falha se algum modulo crescer mais que N bytes em flash ou RAM "
+                             "(0: qualquer crescimento falha)")
+    args = parser.parse_args()
+
+    usage = parse_map(args.map)
+    if not usage:
+        sys.exit(f"{args.map}: nenhuma secao encontrada")
+
+    baseline = None
+    if args.baseline and os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    print_report(usage, baseline)
+
+    if args.save:
+        with open(args.save, "w") as f:
+            json.dump(usage, f, indent=2, sort_keys=True)
+
+    if baseline is not None and args.threshold is not None:
+        grew = []
+        for module, size in usage.items():
+            old = baseline.get(module, {"flash": 0, "ram": 0})
+            for kind in ("flash", "ram"):
+                if size[kind] - old[kind] > args.threshold:
+                    grew.append(f"{module} ({kind} +{size[kind] - old[kind]})")
+        if grew:
+            sys.exit("regressao de memoria: " + ", ".join(grew))
+
+
+if __name__ == "__main__":
+    main()